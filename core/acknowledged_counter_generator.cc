@@ -6,9 +6,48 @@
 //
 
 #include "acknowledged_counter_generator.h"
+
+#include <map>
 #include "utils.h"
 
 namespace ycsbc {
+
+namespace {
+
+struct SharedCounter {
+  AcknowledgedCounterGenerator *counter;
+  uint64_t start;
+  int users;
+};
+
+std::mutex shared_counters_mutex;
+std::map<std::string, SharedCounter> shared_counters;
+
+} // anonymous
+
+AcknowledgedCounterGenerator *AcknowledgedCounterGenerator::Share(const std::string &name,
+                                                                  uint64_t start) {
+  std::lock_guard<std::mutex> lock(shared_counters_mutex);
+  auto it = shared_counters.find(name);
+  if (it == shared_counters.end()) {
+    it = shared_counters.emplace(name, SharedCounter{new AcknowledgedCounterGenerator(start),
+                                                     start, 0}).first;
+  } else if (it->second.start != start) {
+    return nullptr;
+  }
+  it->second.users++;
+  return it->second.counter;
+}
+
+void AcknowledgedCounterGenerator::Release(const std::string &name) {
+  std::lock_guard<std::mutex> lock(shared_counters_mutex);
+  auto it = shared_counters.find(name);
+  if (--it->second.users == 0) {
+    delete it->second.counter;
+    shared_counters.erase(it);
+  }
+}
+
 void AcknowledgedCounterGenerator::Acknowledge(uint64_t value) {
   std::lock_guard<std::mutex> lock(mutex_);
   size_t cur_slot = value & kWindowMask;
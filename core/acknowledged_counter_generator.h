@@ -11,6 +11,7 @@
 #include "counter_generator.h"
 
 #include <atomic>
+#include <string>
 #include <vector>
 #include <mutex>
 
@@ -22,6 +23,14 @@ class AcknowledgedCounterGenerator : public CounterGenerator {
       : CounterGenerator(start), limit_(start - 1), ack_window_(kWindowSize, false) {}
   uint64_t Last() { return limit_.load(); }
   void Acknowledge(uint64_t value);
+
+  ///
+  /// Returns the counter shared under a name, created by the first caller, or
+  /// nullptr if it was created with another start. Every counter returned is
+  /// released with Release.
+  ///
+  static AcknowledgedCounterGenerator *Share(const std::string &name, uint64_t start);
+  static void Release(const std::string &name);
  private:
   static const size_t kWindowSize = (1 << 16);
   static const size_t kWindowMask = kWindowSize - 1;
@@ -8,6 +8,7 @@
 
 #include "basic_db.h"
 #include "core/db_factory.h"
+#include "core/utils.h"
 
 using std::cout;
 using std::endl;
@@ -53,6 +54,34 @@ DB::Status BasicDB::Scan(const std::string &table, const std::string &key, int l
   return kOK;
 }
 
+DB::Status BasicDB::ScanRange(const std::string &table, const std::string &start_key,
+                              const std::string &end_key, int len, bool reverse,
+                              const std::vector<std::string> *fields,
+                              std::vector<std::vector<Field>> &result) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  cout << (reverse ? "REVERSESCAN " : "SCANRANGE ") << table << " [" << start_key << ", "
+       << end_key << ") " << len;
+  if (fields) {
+    cout << " [ ";
+    for (auto f : *fields) {
+      cout << f << ' ';
+    }
+    cout << ']' << endl;
+  } else {
+    cout  << " < all fields >" << endl;
+  }
+  return kOK;
+}
+
+DB::Status BasicDB::FullScan(const std::string &table, const std::string &start_key,
+                             const std::string &end_key, uint64_t &records, uint64_t &bytes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  cout << "FULLSCAN " << table << " [" << start_key << ", " << end_key << ')' << endl;
+  records = 0;
+  bytes = 0;
+  return kOK;
+}
+
 DB::Status BasicDB::Update(const std::string &table, const std::string &key,
                            std::vector<Field> &values) {
   std::lock_guard<std::mutex> lock(mutex_);
@@ -81,6 +110,54 @@ DB::Status BasicDB::Delete(const std::string &table, const std::string &key) {
   return kOK;
 }
 
+DB::Status BasicDB::DeleteRange(const std::string &table, const std::string &start_key,
+                                const std::string &end_key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  cout << "DELETERANGE " << table << " [" << start_key << ", " << end_key << ')' << endl;
+  return kOK;
+}
+
+DB::Status BasicDB::Increment(const std::string &table, const std::string &key,
+                              std::vector<Field> &deltas) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  cout << "INCREMENT " << table << ' ' << key << " [ ";
+  for (auto v : deltas) {
+    cout << v.name << '+' << utils::DecodeFixed64(v.value) << ' ';
+  }
+  cout << ']' << endl;
+  return kOK;
+}
+
+DB::Status BasicDB::Begin() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  cout << "BEGIN" << endl;
+  return kOK;
+}
+
+DB::Status BasicDB::Commit() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  cout << "COMMIT" << endl;
+  return kOK;
+}
+
+DB::Status BasicDB::Rollback() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  cout << "ROLLBACK" << endl;
+  return kOK;
+}
+
+DB::Status BasicDB::HoldSnapshot() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  cout << "HOLDSNAPSHOT" << endl;
+  return kOK;
+}
+
+DB::Status BasicDB::ReleaseSnapshot() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  cout << "RELEASESNAPSHOT" << endl;
+  return kOK;
+}
+
 DB *NewBasicDB() {
   return new BasicDB;
 }
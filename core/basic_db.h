@@ -28,12 +28,35 @@ class BasicDB : public DB {
   Status Scan(const std::string &table, const std::string &key, int len,
               const std::vector<std::string> *fields, std::vector<std::vector<Field>> &result);
 
+  Status ScanRange(const std::string &table, const std::string &start_key,
+                   const std::string &end_key, int len, bool reverse,
+                   const std::vector<std::string> *fields,
+                   std::vector<std::vector<Field>> &result);
+
+  Status FullScan(const std::string &table, const std::string &start_key,
+                  const std::string &end_key, uint64_t &records, uint64_t &bytes);
+
   Status Update(const std::string &table, const std::string &key, std::vector<Field> &values);
 
   Status Insert(const std::string &table, const std::string &key, std::vector<Field> &values);
 
   Status Delete(const std::string &table, const std::string &key);
 
+  Status DeleteRange(const std::string &table, const std::string &start_key,
+                     const std::string &end_key);
+
+  Status Increment(const std::string &table, const std::string &key, std::vector<Field> &deltas);
+
+  Status Begin();
+
+  Status Commit();
+
+  Status Rollback();
+
+  Status HoldSnapshot();
+
+  Status ReleaseSnapshot();
+
  private:
   static std::mutex mutex_;
 };
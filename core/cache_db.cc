@@ -0,0 +1,174 @@
+//
+//  cache_db.cc
+//  YCSB-cpp
+//
+//  Copyright (c) 2020 Youngjae Lee <ls4154.lee@gmail.com>.
+//
+
+#include "cache_db.h"
+#include "core_workload.h"
+#include "utils.h"
+
+namespace ycsbc {
+
+const std::string CacheDB::CACHE_SIZE_PROPERTY = "cache.size";
+const std::string CacheDB::CACHE_SIZE_DEFAULT = "0";
+
+const std::string CacheDB::CACHE_POLICY_PROPERTY = "cache.policy";
+const std::string CacheDB::CACHE_POLICY_DEFAULT = "lru";
+
+const std::string CacheDB::CACHE_SHARDS_PROPERTY = "cache.shards";
+const std::string CacheDB::CACHE_SHARDS_DEFAULT = "16";
+
+const std::string CacheDB::CACHE_WRITE_POLICY_PROPERTY = "cache.writepolicy";
+const std::string CacheDB::CACHE_WRITE_POLICY_DEFAULT = "invalidate";
+
+RowCache *CacheDB::cache_ = nullptr;
+bool CacheDB::write_through_ = false;
+int CacheDB::ref_cnt_ = 0;
+std::mutex CacheDB::mutex_;
+
+void CacheDB::Init() {
+  db_->Init();
+
+  const std::lock_guard<std::mutex> lock(mutex_);
+  if (ref_cnt_++) {
+    return;
+  }
+
+  const utils::Properties &props = *props_;
+  size_t capacity = std::stoul(props.GetProperty(CACHE_SIZE_PROPERTY, CACHE_SIZE_DEFAULT));
+  int num_shards = std::stoi(props.GetProperty(CACHE_SHARDS_PROPERTY, CACHE_SHARDS_DEFAULT));
+  const std::string policy = props.GetProperty(CACHE_POLICY_PROPERTY, CACHE_POLICY_DEFAULT);
+  if (policy == "lru") {
+    cache_ = NewLRURowCache(capacity, num_shards);
+  } else if (policy == "tinylfu") {
+    size_t row_size = std::stoul(props.GetProperty(CoreWorkload::FIELD_COUNT_PROPERTY,
+                                                   CoreWorkload::FIELD_COUNT_DEFAULT))
+                      * std::stoul(props.GetProperty(CoreWorkload::FIELD_LENGTH_PROPERTY,
+                                                     CoreWorkload::FIELD_LENGTH_DEFAULT));
+    cache_ = NewTinyLFURowCache(capacity, num_shards, row_size);
+  } else {
+    throw utils::Exception("Unknown cache policy: " + policy);
+  }
+
+  const std::string write_policy = props.GetProperty(CACHE_WRITE_POLICY_PROPERTY,
+                                                     CACHE_WRITE_POLICY_DEFAULT);
+  if (write_policy == "writethrough") {
+    write_through_ = true;
+  } else if (write_policy == "invalidate") {
+    write_through_ = false;
+  } else {
+    throw utils::Exception("Unknown cache write policy: " + write_policy);
+  }
+}
+
+void CacheDB::Cleanup() {
+  db_->Cleanup();
+
+  const std::lock_guard<std::mutex> lock(mutex_);
+  if (--ref_cnt_) {
+    return;
+  }
+  delete cache_;
+  cache_ = nullptr;
+}
+
+DB::Status CacheDB::Read(const std::string &table, const std::string &key,
+                         const std::vector<std::string> *fields, std::vector<Field> &result) {
+  if (in_transaction_) {
+    return db_->Read(table, key, fields, result);
+  }
+  const std::string cache_key = CacheKey(table, key);
+  std::vector<Field> row;
+
+  timer_.Start();
+  bool hit = cache_->Lookup(cache_key, &row);
+  if (!hit) {
+    // fill the cache with the whole record regardless of the requested fields
+    Status s = db_->Read(table, key, nullptr, row);
+    if (s != kOK) {
+      return s;
+    }
+    cache_->Insert(cache_key, row);
+  }
+  measurements_->Report(hit ? CACHE_HIT : CACHE_MISS, timer_.End());
+
+  if (fields == nullptr) {
+    result.insert(result.end(), row.begin(), row.end());
+  } else {
+    for (const std::string &name : *fields) {
+      for (Field &field : row) {
+        if (field.name == name) {
+          result.push_back(field);
+          break;
+        }
+      }
+    }
+  }
+  return kOK;
+}
+
+DB::Status CacheDB::Update(const std::string &table, const std::string &key,
+                           std::vector<Field> &values) {
+  Status s = db_->Update(table, key, values);
+  if (write_through_ && s == kOK && !in_transaction_) {
+    cache_->Update(CacheKey(table, key), values);
+  } else {
+    cache_->Erase(CacheKey(table, key));
+  }
+  return s;
+}
+
+DB::Status CacheDB::Insert(const std::string &table, const std::string &key,
+                           std::vector<Field> &values) {
+  Status s = db_->Insert(table, key, values);
+  if (write_through_ && s == kOK && !in_transaction_) {
+    cache_->Insert(CacheKey(table, key), values);
+  } else {
+    cache_->Erase(CacheKey(table, key));
+  }
+  return s;
+}
+
+DB::Status CacheDB::Delete(const std::string &table, const std::string &key) {
+  Status s = db_->Delete(table, key);
+  cache_->Erase(CacheKey(table, key));
+  return s;
+}
+
+DB::Status CacheDB::DeleteRange(const std::string &table, const std::string &start_key,
+                                const std::string &end_key) {
+  Status s = db_->DeleteRange(table, start_key, end_key);
+  // cache keys sort by table first, and an empty end key bounds the range by the table
+  cache_->EraseRange(CacheKey(table, start_key),
+                     end_key.empty() ? std::string(table).append(1, '\1')
+                                     : CacheKey(table, end_key));
+  return s;
+}
+
+DB::Status CacheDB::Increment(const std::string &table, const std::string &key,
+                              std::vector<Field> &deltas) {
+  // the new values are not known without a read, so never written through
+  Status s = db_->Increment(table, key, deltas);
+  cache_->Erase(CacheKey(table, key));
+  return s;
+}
+
+DB::Status CacheDB::Begin() {
+  Status s = db_->Begin();
+  in_transaction_ = (s == kOK);
+  return s;
+}
+
+DB::Status CacheDB::Commit() {
+  in_transaction_ = false;
+  return db_->Commit();
+}
+
+DB::Status CacheDB::Rollback() {
+  in_transaction_ = false;
+  return db_->Rollback();
+}
+
+} // ycsbc
@@ -0,0 +1,119 @@
+//
+//  cache_db.h
+//  YCSB-cpp
+//
+//  Copyright (c) 2020 Youngjae Lee <ls4154.lee@gmail.com>.
+//
+
+#ifndef YCSB_C_CACHE_DB_H_
+#define YCSB_C_CACHE_DB_H_
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "db.h"
+#include "measurements.h"
+#include "row_cache.h"
+#include "timer.h"
+
+namespace ycsbc {
+
+///
+/// Look-aside cache in front of another DB. Reads are served from a cache
+/// shared by all threads and filled from the wrapped DB on a miss; writes go
+/// to the wrapped DB and either invalidate or write through the cache.
+/// Within transactions, reads bypass the cache so the wrapped DB sees them,
+/// and writes, which may be rolled back, invalidate it.
+///
+class CacheDB : public DB {
+ public:
+  ///
+  /// The name of the property for the cache capacity in bytes. Zero disables the cache.
+  ///
+  static const std::string CACHE_SIZE_PROPERTY;
+  static const std::string CACHE_SIZE_DEFAULT;
+
+  ///
+  /// The name of the property for the eviction policy.
+  /// Options are "lru" and "tinylfu".
+  ///
+  static const std::string CACHE_POLICY_PROPERTY;
+  static const std::string CACHE_POLICY_DEFAULT;
+
+  ///
+  /// The name of the property for the number of cache shards.
+  ///
+  static const std::string CACHE_SHARDS_PROPERTY;
+  static const std::string CACHE_SHARDS_DEFAULT;
+
+  ///
+  /// The name of the property for the handling of cached records on writes.
+  /// Options are "invalidate" and "writethrough".
+  ///
+  static const std::string CACHE_WRITE_POLICY_PROPERTY;
+  static const std::string CACHE_WRITE_POLICY_DEFAULT;
+
+  CacheDB(DB *db, Measurements *measurements)
+      : db_(db), measurements_(measurements), in_transaction_(false) {}
+  ~CacheDB() {
+    delete db_;
+  }
+
+  void Init();
+  void Cleanup();
+
+  Status Read(const std::string &table, const std::string &key,
+              const std::vector<std::string> *fields, std::vector<Field> &result);
+  Status Scan(const std::string &table, const std::string &key, int record_count,
+              const std::vector<std::string> *fields, std::vector<std::vector<Field>> &result) {
+    return db_->Scan(table, key, record_count, fields, result);
+  }
+  Status ScanRange(const std::string &table, const std::string &start_key,
+                   const std::string &end_key, int record_count, bool reverse,
+                   const std::vector<std::string> *fields,
+                   std::vector<std::vector<Field>> &result) {
+    return db_->ScanRange(table, start_key, end_key, record_count, reverse, fields, result);
+  }
+  Status FullScan(const std::string &table, const std::string &start_key,
+                  const std::string &end_key, uint64_t &records, uint64_t &bytes) {
+    return db_->FullScan(table, start_key, end_key, records, bytes);
+  }
+  Status Update(const std::string &table, const std::string &key, std::vector<Field> &values);
+  Status Insert(const std::string &table, const std::string &key, std::vector<Field> &values);
+  Status Delete(const std::string &table, const std::string &key);
+  Status DeleteRange(const std::string &table, const std::string &start_key,
+                     const std::string &end_key);
+  Status Increment(const std::string &table, const std::string &key, std::vector<Field> &deltas);
+  Status Begin();
+  Status Commit();
+  Status Rollback();
+  Status HoldSnapshot() {
+    return db_->HoldSnapshot();
+  }
+  Status ReleaseSnapshot() {
+    return db_->ReleaseSnapshot();
+  }
+  Status GetSpaceStats(std::map<std::string, uint64_t> &stats) {
+    return db_->GetSpaceStats(stats);
+  }
+
+ private:
+  static std::string CacheKey(const std::string &table, const std::string &key) {
+    return std::string(table).append(1, '\0').append(key);
+  }
+
+  DB *db_;
+  Measurements *measurements_;
+  utils::Timer<uint64_t, std::nano> timer_;
+  bool in_transaction_;
+
+  static RowCache *cache_;
+  static bool write_through_;
+  static int ref_cnt_;
+  static std::mutex mutex_;
+};
+
+} // ycsbc
+
+#endif // YCSB_C_CACHE_DB_H_
@@ -9,30 +9,44 @@
 #ifndef YCSB_C_CLIENT_H_
 #define YCSB_C_CLIENT_H_
 
+#include <chrono>
 #include <string>
+#include <thread>
 #include "db.h"
-#include "core_workload.h"
+#include "workload.h"
 #include "utils.h"
 #include "countdown_latch.h"
 
 namespace ycsbc {
 
-inline int ClientThread(ycsbc::DB *db, ycsbc::CoreWorkload *wl, const int num_ops, bool is_loading,
-                        bool init_db, bool cleanup_db, CountDownLatch *latch) {
+inline int ClientThread(ycsbc::DB *db, ycsbc::Workload *wl, int thread_id, int thread_count,
+                        const int num_ops, bool is_loading, bool init_db, bool cleanup_db,
+                        CountDownLatch *latch, double target_ops_per_sec = 0) {
+  using Clock = std::chrono::steady_clock;
   if (init_db) {
     db->Init();
   }
+  Workload::ThreadState *state = wl->InitThread(thread_id, thread_count);
 
+  Clock::time_point start = Clock::now();
   int ops = 0;
   for (int i = 0; i < num_ops; ++i) {
     if (is_loading) {
-      wl->DoInsert(*db);
+      wl->DoInsert(*db, state);
     } else {
-      wl->DoTransaction(*db);
+      wl->DoTransaction(*db, state);
     }
     ops++;
+
+    if (target_ops_per_sec > 0) {
+      // throttle to the target rate by sleeping until the next op is due
+      std::chrono::duration<double> due(ops / target_ops_per_sec);
+      std::this_thread::sleep_until(start + std::chrono::duration_cast<Clock::duration>(due));
+    }
   }
 
+  delete state;
+
   if (cleanup_db) {
     db->Cleanup();
   }
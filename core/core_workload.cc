@@ -10,18 +10,45 @@
 #include "uniform_generator.h"
 #include "zipfian_generator.h"
 #include "scrambled_zipfian_generator.h"
+#include "growing_zipfian_generator.h"
 #include "skewed_latest_generator.h"
+#include "hotspot_generator.h"
+#include "empirical_generator.h"
 #include "const_generator.h"
 #include "core_workload.h"
+#include "workload_factory.h"
 #include "random_byte_generator.h"
+#include "measurements.h"
+#include "timer.h"
 
 #include <algorithm>
+#include <cmath>
+#include <functional>
 #include <random>
 #include <string>
 
 using ycsbc::CoreWorkload;
 using std::string;
 
+namespace {
+
+const size_t kPerKeySamples = 1 << 16;
+// 256 MB of versions
+const uint64_t kMaxVersionedRecords = 1 << 26;
+const uint64_t kMaxFieldLength = 1 << 20;
+
+// A record's values are looked up by key hash in a sample of a distribution. The
+// sample is taken at evenly spaced quantiles, so it is the same in every process.
+std::vector<uint64_t> QuantileSamples(const std::function<uint64_t(double)> &value_at) {
+  std::vector<uint64_t> samples(kPerKeySamples);
+  for (size_t i = 0; i < samples.size(); ++i) {
+    samples[i] = value_at((i + 0.5) / samples.size());
+  }
+  return samples;
+}
+
+} // anonymous
+
 const char *ycsbc::kOperationString[ycsbc::MAXOPTYPE] = {
   "INSERT",
   "READ",
@@ -29,23 +56,53 @@ const char *ycsbc::kOperationString[ycsbc::MAXOPTYPE] = {
   "SCAN",
   "READMODIFYWRITE",
   "DELETE",
+  "INCREMENT",
+  "REVERSESCAN",
+  "DELETERANGE",
+  "TRANSACTION",
+  "COMMIT",
+  "FULLSCAN",
   "INSERT-FAILED",
   "READ-FAILED",
   "UPDATE-FAILED",
   "SCAN-FAILED",
   "READMODIFYWRITE-FAILED",
-  "DELETE-FAILED"
+  "DELETE-FAILED",
+  "INCREMENT-FAILED",
+  "REVERSESCAN-FAILED",
+  "DELETERANGE-FAILED",
+  "TRANSACTION-FAILED",
+  "COMMIT-FAILED",
+  "FULLSCAN-FAILED",
+  "CACHE-HIT",
+  "CACHE-MISS"
 };
 
 const string CoreWorkload::TABLENAME_PROPERTY = "table";
 const string CoreWorkload::TABLENAME_DEFAULT = "usertable";
 
+const string CoreWorkload::TABLE_COUNT_PROPERTY = "tablecount";
+const string CoreWorkload::TABLE_COUNT_DEFAULT = "1";
+
 const string CoreWorkload::FIELD_COUNT_PROPERTY = "fieldcount";
 const string CoreWorkload::FIELD_COUNT_DEFAULT = "10";
 
+const string CoreWorkload::FIELD_COUNT_DISTRIBUTION_PROPERTY = "fieldcountdistribution";
+const string CoreWorkload::FIELD_COUNT_DISTRIBUTION_DEFAULT = "constant";
+const string CoreWorkload::FIELD_COUNT_HISTOGRAM_PROPERTY = "fieldcounthistogram";
+
+const string CoreWorkload::FIELD_DISTRIBUTION_PROPERTY = "fielddistribution";
+const string CoreWorkload::FIELD_DISTRIBUTION_DEFAULT = "uniform";
+const string CoreWorkload::FIELD_HISTOGRAM_PROPERTY = "fieldhistogram";
+
 const string CoreWorkload::FIELD_LENGTH_DISTRIBUTION_PROPERTY = "field_len_dist";
 const string CoreWorkload::FIELD_LENGTH_DISTRIBUTION_DEFAULT = "constant";
 
+const string CoreWorkload::FIELD_LENGTH_HISTOGRAM_PROPERTY = "fieldlengthhistogram";
+
+const string CoreWorkload::FIELD_LENGTH_GROWTH_PROPERTY = "fieldlengthgrowth";
+const string CoreWorkload::FIELD_LENGTH_GROWTH_DEFAULT = "1";
+
 const string CoreWorkload::FIELD_LENGTH_PROPERTY = "fieldlength";
 const string CoreWorkload::FIELD_LENGTH_DEFAULT = "100";
 
@@ -67,12 +124,26 @@ const string CoreWorkload::INSERT_PROPORTION_DEFAULT = "0.0";
 const string CoreWorkload::SCAN_PROPORTION_PROPERTY = "scanproportion";
 const string CoreWorkload::SCAN_PROPORTION_DEFAULT = "0.0";
 
+const string CoreWorkload::REVERSE_SCAN_PROPORTION_PROPERTY = "reversescanproportion";
+const string CoreWorkload::REVERSE_SCAN_PROPORTION_DEFAULT = "0.0";
+
+const string CoreWorkload::DELETE_RANGE_PROPORTION_PROPERTY = "deleterangeproportion";
+const string CoreWorkload::DELETE_RANGE_PROPORTION_DEFAULT = "0.0";
+
 const string CoreWorkload::READMODIFYWRITE_PROPORTION_PROPERTY = "readmodifywriteproportion";
 const string CoreWorkload::READMODIFYWRITE_PROPORTION_DEFAULT = "0.0";
 
 const string CoreWorkload::REQUEST_DISTRIBUTION_PROPERTY = "requestdistribution";
 const string CoreWorkload::REQUEST_DISTRIBUTION_DEFAULT = "uniform";
 
+const string CoreWorkload::REQUEST_HISTOGRAM_PROPERTY = "requesthistogram";
+
+const string CoreWorkload::HOTSPOT_DATA_FRACTION_PROPERTY = "hotspotdatafraction";
+const string CoreWorkload::HOTSPOT_DATA_FRACTION_DEFAULT = "0.2";
+
+const string CoreWorkload::HOTSPOT_OPN_FRACTION_PROPERTY = "hotspotopnfraction";
+const string CoreWorkload::HOTSPOT_OPN_FRACTION_DEFAULT = "0.8";
+
 const string CoreWorkload::ZERO_PADDING_PROPERTY = "zeropadding";
 const string CoreWorkload::ZERO_PADDING_DEFAULT = "1";
 
@@ -85,6 +156,18 @@ const string CoreWorkload::MAX_SCAN_LENGTH_DEFAULT = "1000";
 const string CoreWorkload::SCAN_LENGTH_DISTRIBUTION_PROPERTY = "scanlengthdistribution";
 const string CoreWorkload::SCAN_LENGTH_DISTRIBUTION_DEFAULT = "uniform";
 
+const string CoreWorkload::SCAN_LENGTH_HISTOGRAM_PROPERTY = "scanlengthhistogram";
+
+const string CoreWorkload::MIN_DELETE_RANGE_LENGTH_PROPERTY = "mindeleterangelength";
+const string CoreWorkload::MIN_DELETE_RANGE_LENGTH_DEFAULT = "1";
+
+const string CoreWorkload::MAX_DELETE_RANGE_LENGTH_PROPERTY = "maxdeleterangelength";
+const string CoreWorkload::MAX_DELETE_RANGE_LENGTH_DEFAULT = "100";
+
+const string CoreWorkload::DELETE_RANGE_LENGTH_DISTRIBUTION_PROPERTY =
+    "deleterangelengthdistribution";
+const string CoreWorkload::DELETE_RANGE_LENGTH_DISTRIBUTION_DEFAULT = "uniform";
+
 const string CoreWorkload::INSERT_ORDER_PROPERTY = "insertorder";
 const string CoreWorkload::INSERT_ORDER_DEFAULT = "hashed";
 
@@ -102,12 +185,54 @@ const std::string CoreWorkload::ZIPFIAN_CONSTANT_DEFAULT = "0.98";
 
 namespace ycsbc {
 
+const std::string CoreWorkload::MRC_SAMPLING_RATE_PROPERTY = "mrc.samplingrate";
+const std::string CoreWorkload::MRC_SAMPLING_RATE_DEFAULT = "0";
+
+const std::string CoreWorkload::HOT_KEYS_PROPERTY = "hotkeys.topk";
+const std::string CoreWorkload::HOT_KEYS_DEFAULT = "0";
+
+const std::string CoreWorkload::HOT_KEYS_SKETCH_WIDTH_PROPERTY = "hotkeys.sketchwidth";
+const std::string CoreWorkload::HOT_KEYS_SKETCH_WIDTH_DEFAULT = "65536";
+
 void CoreWorkload::Init(const utils::Properties &p) {
   table_name_ = p.GetProperty(TABLENAME_PROPERTY,TABLENAME_DEFAULT);
+  int table_count = std::stoi(p.GetProperty(TABLE_COUNT_PROPERTY, TABLE_COUNT_DEFAULT));
+  if (table_count < 1) {
+    throw utils::Exception("tablecount must be positive");
+  } else if (table_count == 1) {
+    table_names_.push_back(table_name_);
+  } else {
+    for (int i = 0; i < table_count; i++) {
+      table_names_.push_back(table_name_ + std::to_string(i));
+    }
+  }
 
   field_count_ = std::stoi(p.GetProperty(FIELD_COUNT_PROPERTY, FIELD_COUNT_DEFAULT));
   field_prefix_ = p.GetProperty(FIELD_NAME_PREFIX, FIELD_NAME_PREFIX_DEFAULT);
-  field_len_generator_ = GetFieldLenGenerator(p);
+  field_len_samples_ = GetFieldLenSamples(p);
+  field_len_growth_ = std::stod(p.GetProperty(FIELD_LENGTH_GROWTH_PROPERTY,
+                                              FIELD_LENGTH_GROWTH_DEFAULT));
+
+  std::string field_count_dist = p.GetProperty(FIELD_COUNT_DISTRIBUTION_PROPERTY,
+                                               FIELD_COUNT_DISTRIBUTION_DEFAULT);
+  // like the field lengths, a record's field count is looked up by key hash
+  if (field_count_dist == "uniform") {
+    field_count_samples_ = QuantileSamples([&](double u) {
+      return 1 + static_cast<uint64_t>(u * field_count_);
+    });
+  } else if (field_count_dist == "zipfian") {
+    ZipfianGenerator generator(1, field_count_);
+    field_count_samples_ = QuantileSamples([&](double u) { return generator.ValueAt(u); });
+  } else if (field_count_dist == "empirical") {
+    EmpiricalGenerator generator(EmpiricalGenerator::LoadBuckets(
+        p.GetProperty(FIELD_COUNT_HISTOGRAM_PROPERTY)));
+    if (generator.Min() < 1 || generator.Max() > static_cast<uint64_t>(field_count_)) {
+      throw utils::Exception("Field counts must be between 1 and fieldcount");
+    }
+    field_count_samples_ = QuantileSamples([&](double u) { return generator.ValueAt(u); });
+  } else if (field_count_dist != "constant") {
+    throw utils::Exception("Unknown field count distribution: " + field_count_dist);
+  }
 
   double read_proportion = std::stod(p.GetProperty(READ_PROPORTION_PROPERTY,
                                                    READ_PROPORTION_DEFAULT));
@@ -117,14 +242,14 @@ void CoreWorkload::Init(const utils::Properties &p) {
                                                      INSERT_PROPORTION_DEFAULT));
   double scan_proportion = std::stod(p.GetProperty(SCAN_PROPORTION_PROPERTY,
                                                    SCAN_PROPORTION_DEFAULT));
+  double reverse_scan_proportion = std::stod(p.GetProperty(REVERSE_SCAN_PROPORTION_PROPERTY,
+                                                           REVERSE_SCAN_PROPORTION_DEFAULT));
+  double delete_range_proportion = std::stod(p.GetProperty(DELETE_RANGE_PROPORTION_PROPERTY,
+                                                           DELETE_RANGE_PROPORTION_DEFAULT));
   double readmodifywrite_proportion = std::stod(p.GetProperty(
       READMODIFYWRITE_PROPORTION_PROPERTY, READMODIFYWRITE_PROPORTION_DEFAULT));
 
-  double zipfian_constant = std::stod(p.GetProperty(ZIPFIAN_CONSTANT, ZIPFIAN_CONSTANT_DEFAULT));
-
   record_count_ = std::stoi(p.GetProperty(RECORD_COUNT_PROPERTY));
-  std::string request_dist = p.GetProperty(REQUEST_DISTRIBUTION_PROPERTY,
-                                           REQUEST_DISTRIBUTION_DEFAULT);
   int min_scan_len = std::stoi(p.GetProperty(MIN_SCAN_LENGTH_PROPERTY, MIN_SCAN_LENGTH_DEFAULT));
   int max_scan_len = std::stoi(p.GetProperty(MAX_SCAN_LENGTH_PROPERTY, MAX_SCAN_LENGTH_DEFAULT));
   std::string scan_len_dist = p.GetProperty(SCAN_LENGTH_DISTRIBUTION_PROPERTY,
@@ -157,70 +282,215 @@ void CoreWorkload::Init(const utils::Properties &p) {
   if (scan_proportion > 0) {
     op_chooser_.AddValue(SCAN, scan_proportion);
   }
+  if (reverse_scan_proportion > 0) {
+    op_chooser_.AddValue(REVERSE_SCAN, reverse_scan_proportion);
+  }
+  if (delete_range_proportion > 0) {
+    op_chooser_.AddValue(DELETE_RANGE, delete_range_proportion);
+  }
   if (readmodifywrite_proportion > 0) {
     op_chooser_.AddValue(READMODIFYWRITE, readmodifywrite_proportion);
   }
 
-  insert_key_sequence_ = new CounterGenerator(insert_start);
-  transaction_insert_key_sequence_ = new AcknowledgedCounterGenerator(record_count_);
-
-  if (request_dist == "uniform") {
-    key_chooser_ = new UniformGenerator(0, record_count_ - 1);
-
-  } else if (request_dist == "zipfian") {
-    // If the number of keys changes, we don't want to change popular keys.
-    // So we construct the scrambled zipfian generator with a keyspace
-    // that is larger than what exists at the beginning of the test.
-    // If the generator picks a key that is not inserted yet, we just ignore it
-    // and pick another key.
-    int op_count = std::stoi(p.GetProperty(OPERATION_COUNT_PROPERTY));
-    // int new_keys = (int)(op_count * insert_proportion * 2); // a fudge factor
-    // key_chooser_ = new ScrambledZipfianGenerator(record_count_ + new_keys);
-
-    key_chooser_ = new ScrambledZipfianGenerator(record_count_, zipfian_constant);
-    key_chooser_->SetOperationCount(op_count);
-    update_key_chooser_ = new ScrambledZipfianGenerator(record_count_, zipfian_constant);
-    update_key_chooser_->SetOperationCount(op_count);
-    read_key_chooser_ = new ScrambledZipfianGenerator(record_count_, zipfian_constant);
-    read_key_chooser_->SetOperationCount(op_count);
+  if (field_len_growth_ != 1.0) {
+    // one version per key number: the loaded records and one insert per operation
+    uint64_t operation_count = std::stoull(p.GetProperty(OPERATION_COUNT_PROPERTY, "0"));
+    uint64_t records = std::max<uint64_t>(insert_start + record_count_,
+                                          record_count_ + operation_count);
+    if (records > kMaxVersionedRecords) {
+      throw utils::Exception("fieldlengthgrowth tracks the versions of at most " +
+                             std::to_string(kMaxVersionedRecords) + " records");
+    }
+    record_versions_ = std::vector<std::atomic<uint32_t>>(records);
+  }
 
-  } else if (request_dist == "latest") {
-    key_chooser_ = new SkewedLatestGenerator(*transaction_insert_key_sequence_);
+  insert_key_sequence_ = new CounterGenerator(insert_start);
+  // client groups on the same table share its transaction inserts, so that they neither
+  // overwrite each other's records nor miss them when choosing keys
+  transaction_insert_key_sequence_ = AcknowledgedCounterGenerator::Share(table_name_,
+                                                                         record_count_);
+  if (transaction_insert_key_sequence_ == nullptr) {
+    throw utils::Exception("Client groups on table " + table_name_ +
+                           " must have the same recordcount");
+  }
 
+  key_chooser_ = GetKeyChooser(p, "");
+  read_key_chooser_ = GetKeyChooser(p, "read.");
+  update_key_chooser_ = GetKeyChooser(p, "update.");
+  scan_key_chooser_ = GetKeyChooser(p, "scan.");
+
+  std::string field_dist = p.GetProperty(FIELD_DISTRIBUTION_PROPERTY, FIELD_DISTRIBUTION_DEFAULT);
+  if (field_dist == "uniform") {
+    field_chooser_ = new UniformGenerator(0, field_count_ - 1);
+  } else if (field_dist == "zipfian") {
+    field_chooser_ = new ZipfianGenerator(0, field_count_ - 1);
+  } else if (field_dist == "empirical") {
+    EmpiricalGenerator *generator = new EmpiricalGenerator(EmpiricalGenerator::LoadBuckets(
+        p.GetProperty(FIELD_HISTOGRAM_PROPERTY)));
+    field_chooser_ = generator;
+    if (generator->Max() >= static_cast<uint64_t>(field_count_)) {
+      throw utils::Exception("Field numbers must be below fieldcount");
+    }
   } else {
-    throw utils::Exception("Unknown request distribution: " + request_dist);
+    throw utils::Exception("Unknown field distribution: " + field_dist);
   }
 
-  field_chooser_ = new UniformGenerator(0, field_count_ - 1);
-
   if (scan_len_dist == "uniform") {
     scan_len_chooser_ = new UniformGenerator(min_scan_len, max_scan_len);
   } else if (scan_len_dist == "zipfian") {
     scan_len_chooser_ = new ZipfianGenerator(min_scan_len, max_scan_len);
+  } else if (scan_len_dist == "empirical") {
+    scan_len_chooser_ = new EmpiricalGenerator(EmpiricalGenerator::LoadBuckets(
+        p.GetProperty(SCAN_LENGTH_HISTOGRAM_PROPERTY)));
   } else {
     throw utils::Exception("Distribution not allowed for scan length: " + scan_len_dist);
   }
+
+  uint64_t min_delete_range_len = std::stoull(p.GetProperty(MIN_DELETE_RANGE_LENGTH_PROPERTY,
+                                                            MIN_DELETE_RANGE_LENGTH_DEFAULT));
+  uint64_t max_delete_range_len = std::stoull(p.GetProperty(MAX_DELETE_RANGE_LENGTH_PROPERTY,
+                                                            MAX_DELETE_RANGE_LENGTH_DEFAULT));
+  if (min_delete_range_len == 0 || min_delete_range_len > max_delete_range_len) {
+    throw utils::Exception("mindeleterangelength must be positive and at most "
+                           "maxdeleterangelength");
+  }
+  std::string delete_range_len_dist = p.GetProperty(DELETE_RANGE_LENGTH_DISTRIBUTION_PROPERTY,
+                                                    DELETE_RANGE_LENGTH_DISTRIBUTION_DEFAULT);
+  if (delete_range_len_dist == "uniform") {
+    delete_range_len_chooser_ = new UniformGenerator(min_delete_range_len, max_delete_range_len);
+  } else if (delete_range_len_dist == "zipfian") {
+    delete_range_len_chooser_ = new ZipfianGenerator(min_delete_range_len, max_delete_range_len);
+  } else {
+    throw utils::Exception("Distribution not allowed for range deletion length: " +
+                           delete_range_len_dist);
+  }
+  // a range of key numbers is a contiguous run of keys only if keys sort as their numbers,
+  // up to the end of a range after the last loaded or inserted record
+  uint64_t inserts = insert_proportion > 0 ?
+      std::stoull(p.GetProperty(OPERATION_COUNT_PROPERTY, "0")) : 0;
+  uint64_t max_key_num = std::max<uint64_t>(insert_start + record_count_,
+                                            record_count_ + inserts) + max_delete_range_len;
+  int key_digits = std::to_string(max_key_num).size();
+  if (delete_range_proportion > 0 && (!ordered_inserts_ || zero_padding_ < key_digits)) {
+    throw utils::Exception("deleterangeproportion needs insertorder=ordered and a zeropadding "
+                           "as wide as the largest key number, " + std::to_string(max_key_num));
+  }
+
+  double mrc_sampling_rate = std::stod(p.GetProperty(MRC_SAMPLING_RATE_PROPERTY,
+                                                     MRC_SAMPLING_RATE_DEFAULT));
+  if (mrc_sampling_rate > 0) {
+    // records not written during the run are assumed to have the mean size
+    std::vector<DB::Field> values;
+    uint64_t record_size = 0;
+    const int kSizeSamples = 64;
+    for (int i = 0; i < kSizeSamples; i++) {
+      values.clear();
+      BuildValues(i, 0, values);
+      for (const DB::Field &field : values) {
+        record_size += field.name.size() + field.value.size();
+      }
+    }
+    record_size = record_size / kSizeSamples + BuildKeyName(record_count_).size();
+    reuse_analyzer_ = new ReuseDistanceAnalyzer(mrc_sampling_rate, record_size);
+  }
+
+  int hot_keys = std::stoi(p.GetProperty(HOT_KEYS_PROPERTY, HOT_KEYS_DEFAULT));
+  if (hot_keys > 0) {
+    size_t sketch_width = std::stoul(p.GetProperty(HOT_KEYS_SKETCH_WIDTH_PROPERTY,
+                                                   HOT_KEYS_SKETCH_WIDTH_DEFAULT));
+    hot_keys_ = new HotKeyTracker(hot_keys, sketch_width);
+  }
 }
 
-ycsbc::Generator<uint64_t> *CoreWorkload::GetFieldLenGenerator(
-    const utils::Properties &p) {
+std::vector<uint64_t> CoreWorkload::GetFieldLenSamples(const utils::Properties &p) {
   string field_len_dist = p.GetProperty(FIELD_LENGTH_DISTRIBUTION_PROPERTY,
                                         FIELD_LENGTH_DISTRIBUTION_DEFAULT);
-  int field_len = std::stoi(p.GetProperty(FIELD_LENGTH_PROPERTY, FIELD_LENGTH_DEFAULT));
+  uint64_t field_len = std::stoull(p.GetProperty(FIELD_LENGTH_PROPERTY, FIELD_LENGTH_DEFAULT));
   if(field_len_dist == "constant") {
-    return new ConstGenerator(field_len);
+    return QuantileSamples([&](double u) { return field_len; });
   } else if(field_len_dist == "uniform") {
-    return new UniformGenerator(1, field_len);
+    return QuantileSamples([&](double u) { return 1 + static_cast<uint64_t>(u * field_len); });
   } else if(field_len_dist == "zipfian") {
-    return new ZipfianGenerator(1, field_len);
+    ZipfianGenerator generator(1, field_len);
+    return QuantileSamples([&](double u) { return generator.ValueAt(u); });
+  } else if(field_len_dist == "empirical") {
+    EmpiricalGenerator generator(EmpiricalGenerator::LoadBuckets(
+        p.GetProperty(FIELD_LENGTH_HISTOGRAM_PROPERTY)));
+    return QuantileSamples([&](double u) { return generator.ValueAt(u); });
   } else {
     throw utils::Exception("Unknown field length distribution: " + field_len_dist);
   }
 }
 
+ycsbc::Generator<uint64_t> *CoreWorkload::GetKeyChooser(const utils::Properties &p,
+                                                       const std::string &prefix) {
+  const std::vector<std::string> keys = {
+    REQUEST_DISTRIBUTION_PROPERTY, ZIPFIAN_CONSTANT, HOTSPOT_DATA_FRACTION_PROPERTY,
+    HOTSPOT_OPN_FRACTION_PROPERTY, REQUEST_HISTOGRAM_PROPERTY
+  };
+  if (!prefix.empty()) {
+    bool overridden = false;
+    for (const std::string &key : keys) {
+      overridden = overridden || p.ContainsKey(prefix + key);
+    }
+    if (!overridden) {
+      return key_chooser_;
+    }
+  }
+  // prefixed properties fall back to the global ones
+  auto get = [&](const std::string &key, const std::string &default_value) {
+    return p.GetProperty(prefix + key, p.GetProperty(key, default_value));
+  };
+  std::string request_dist = get(REQUEST_DISTRIBUTION_PROPERTY, REQUEST_DISTRIBUTION_DEFAULT);
+  double zipfian_constant = std::stod(get(ZIPFIAN_CONSTANT, ZIPFIAN_CONSTANT_DEFAULT));
+
+  if (request_dist == "uniform") {
+    return new UniformGenerator(0, record_count_ - 1);
+
+  } else if (request_dist == "zipfian") {
+    // If the number of keys changes, we don't want to change popular keys.
+    // So we construct the scrambled zipfian generator with a keyspace
+    // that is larger than what exists at the beginning of the test.
+    // If the generator picks a key that is not inserted yet, we just ignore it
+    // and pick another key.
+    double insert_proportion = std::stod(p.GetProperty(INSERT_PROPORTION_PROPERTY,
+                                                       INSERT_PROPORTION_DEFAULT));
+    if (insert_proportion > 0) {
+      // follow the keyspace instead, so that inserted keys are chosen as well
+      return new GrowingZipfianGenerator(*transaction_insert_key_sequence_, record_count_,
+                                         zipfian_constant);
+    }
+    int op_count = std::stoi(p.GetProperty(OPERATION_COUNT_PROPERTY));
+    // int new_keys = (int)(op_count * insert_proportion * 2); // a fudge factor
+    // key_chooser_ = new ScrambledZipfianGenerator(record_count_ + new_keys);
+
+    ScrambledZipfianGenerator *chooser = new ScrambledZipfianGenerator(record_count_,
+                                                                       zipfian_constant);
+    chooser->SetOperationCount(op_count);
+    return chooser;
+
+  } else if (request_dist == "latest") {
+    return new SkewedLatestGenerator(*transaction_insert_key_sequence_);
+
+  } else if (request_dist == "hotspot") {
+    double hot_set_fraction = std::stod(get(HOTSPOT_DATA_FRACTION_PROPERTY,
+                                            HOTSPOT_DATA_FRACTION_DEFAULT));
+    double hot_opn_fraction = std::stod(get(HOTSPOT_OPN_FRACTION_PROPERTY,
+                                            HOTSPOT_OPN_FRACTION_DEFAULT));
+    return new HotspotGenerator(0, record_count_ - 1, hot_set_fraction, hot_opn_fraction);
+
+  } else if (request_dist == "empirical") {
+    return new ScrambledEmpiricalGenerator(
+        EmpiricalGenerator::LoadBuckets(get(REQUEST_HISTOGRAM_PROPERTY, "")), record_count_);
+
+  } else {
+    throw utils::Exception("Unknown request distribution: " + request_dist);
+  }
+}
+
 std::string CoreWorkload::BuildKeyName(uint64_t key_num) {
   if (!ordered_inserts_) {
-    key_num = utils::Hash(key_num);
+    key_num = key_permutation_.Permute(key_num);
   }
   std::string prekey = "user";
   std::string value = std::to_string(key_num);
@@ -228,32 +498,93 @@ std::string CoreWorkload::BuildKeyName(uint64_t key_num) {
   return prekey.append(fill, '0').append(value);
 }
 
-void CoreWorkload::BuildValues(std::vector<ycsbc::DB::Field> &values) {
-  for (int i = 0; i < field_count_; ++i) {
+void CoreWorkload::BuildValues(uint64_t key_num, uint32_t version,
+                               std::vector<ycsbc::DB::Field> &values) {
+  int field_count = RecordFieldCount(key_num);
+  for (int i = 0; i < field_count; ++i) {
     values.push_back(DB::Field());
     ycsbc::DB::Field &field = values.back();
     field.name.append(field_prefix_).append(std::to_string(i));
-    uint64_t len = field_len_generator_->Next();
+    uint64_t len = FieldLength(key_num, i, version);
     field.value.reserve(len);
     RandomByteGenerator byte_generator;
     std::generate_n(std::back_inserter(field.value), len, [&]() { return byte_generator.Next(); } );
   }
 }
 
-void CoreWorkload::BuildSingleValue(std::vector<ycsbc::DB::Field> &values) {
+uint64_t CoreWorkload::FieldLength(uint64_t key_num, int field, uint32_t version) const {
+  uint64_t hash = utils::Hash(utils::Hash(key_num) + field);
+  uint64_t len = field_len_samples_[hash % field_len_samples_.size()];
+  if (version > 0) {
+    double scaled = len * std::pow(field_len_growth_, version);
+    if (scaled > kMaxFieldLength) {
+      throw utils::Exception("fieldlengthgrowth grew a field past " +
+                             std::to_string(kMaxFieldLength) + " bytes");
+    }
+    len = std::max(1.0, scaled);
+  }
+  return len;
+}
+
+int CoreWorkload::RecordFieldCount(uint64_t key_num) const {
+  if (field_count_samples_.empty()) {
+    return field_count_;
+  }
+  return field_count_samples_[utils::Hash(key_num) % field_count_samples_.size()];
+}
+
+uint32_t CoreWorkload::RecordVersion(uint64_t key_num) {
+  if (record_versions_.empty()) {
+    return 0;
+  }
+  return record_versions_.at(key_num).load(std::memory_order_relaxed);
+}
+
+uint32_t CoreWorkload::NextRecordVersion(uint64_t key_num) {
+  if (record_versions_.empty()) {
+    return 0;
+  }
+  return record_versions_.at(key_num).fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+void CoreWorkload::RecordAccess(uint64_t key_num, const std::vector<DB::Field> *values) {
+  if (hot_keys_ != nullptr) {
+    hot_keys_->Access(key_num);
+  }
+  if (reuse_analyzer_ == nullptr) {
+    return;
+  }
+  uint64_t record_size = 0;
+  if (values != nullptr) {
+    record_size = BuildKeyName(key_num).size();
+    for (const DB::Field &field : *values) {
+      record_size += field.name.size() + field.value.size();
+    }
+  }
+  reuse_analyzer_->Access(key_num, record_size);
+}
+
+void CoreWorkload::BuildSingleValue(uint64_t key_num, uint32_t version,
+                                    std::vector<ycsbc::DB::Field> &values) {
   values.push_back(DB::Field());
   ycsbc::DB::Field &field = values.back();
-  field.name.append(NextFieldName());
-  uint64_t len = field_len_generator_->Next();
+  // only fields the record has are updated, so sparse records keep their field count
+  int field_count = RecordFieldCount(key_num);
+  int field_num;
+  do {
+    field_num = field_chooser_->Next();
+  } while (field_num >= field_count);
+  field.name.append(field_prefix_).append(std::to_string(field_num));
+  uint64_t len = FieldLength(key_num, field_num, version);
   field.value.reserve(len);
   RandomByteGenerator byte_generator;
   std::generate_n(std::back_inserter(field.value), len, [&]() { return byte_generator.Next(); } );
 }
 
-uint64_t CoreWorkload::NextTransactionKeyNum() {
+uint64_t CoreWorkload::NextTransactionKeyNum(Generator<uint64_t> *chooser) {
   uint64_t key_num;
   do {
-    key_num = key_chooser_->Next();
+    key_num = chooser->Next();
   } while (key_num > transaction_insert_key_sequence_->Last());
   return key_num;
 }
@@ -262,14 +593,15 @@ std::string CoreWorkload::NextFieldName() {
   return std::string(field_prefix_).append(std::to_string(field_chooser_->Next()));
 }
 
-bool CoreWorkload::DoInsert(DB &db) {
-  const std::string key = BuildKeyName(insert_key_sequence_->Next());
+bool CoreWorkload::DoInsert(DB &db, ThreadState *state) {
+  uint64_t key_num = insert_key_sequence_->Next();
+  const std::string key = BuildKeyName(key_num);
   std::vector<DB::Field> fields;
-  BuildValues(fields);
-  return db.Insert(table_name_, key, fields) == DB::kOK;
+  BuildValues(key_num, 0, fields);
+  return db.Insert(TableName(key_num), key, fields) == DB::kOK;
 }
 
-bool CoreWorkload::DoTransaction(DB &db) {
+bool CoreWorkload::DoTransaction(DB &db, ThreadState *state) {
   DB::Status status;
   switch (op_chooser_.Next()) {
     case READ:
@@ -284,6 +616,12 @@ bool CoreWorkload::DoTransaction(DB &db) {
     case SCAN:
       status = TransactionScan(db);
       break;
+    case REVERSE_SCAN:
+      status = TransactionReverseScan(db);
+      break;
+    case DELETE_RANGE:
+      status = TransactionDeleteRange(db);
+      break;
     case READMODIFYWRITE:
       status = TransactionReadModifyWrite(db);
       break;
@@ -293,75 +631,152 @@ bool CoreWorkload::DoTransaction(DB &db) {
   return (status == DB::kOK);
 }
 
+void CoreWorkload::PrintReport(std::ostream &os, const std::string &prefix) {
+  if (reuse_analyzer_ != nullptr) {
+    reuse_analyzer_->PrintCurve(os, prefix);
+  }
+  if (hot_keys_ != nullptr) {
+    uint64_t total;
+    std::vector<HotKeyTracker::HotKey> keys = hot_keys_->TopKeys(&total);
+    uint64_t hot_total = 0;
+    for (const HotKeyTracker::HotKey &key : keys) {
+      hot_total += key.count;
+    }
+    os << prefix << "Hot keys: top " << keys.size() << " of " << total << " accesses receive "
+       << (total ? 100.0 * hot_total / total : 0) << "%, estimated skew "
+       << HotKeyTracker::EstimateSkew(keys) << std::endl;
+    for (size_t i = 0; i < keys.size(); i++) {
+      os << prefix << "Hot key " << i + 1 << ": " << TableName(keys[i].key_num) << ' '
+         << BuildKeyName(keys[i].key_num) << ' ' << keys[i].count << " ("
+         << (total ? 100.0 * keys[i].count / total : 0) << "%)" << std::endl;
+    }
+  }
+}
+
 DB::Status CoreWorkload::TransactionRead(DB &db) {
-  uint64_t key_num = NextTransactionKeyNum();
+  uint64_t key_num = NextTransactionKeyNum(read_key_chooser_);
+  RecordAccess(key_num);
   const std::string key = BuildKeyName(key_num);
   std::vector<DB::Field> result;
   if (!read_all_fields()) {
     std::vector<std::string> fields;
     fields.push_back(NextFieldName());
-    return db.Read(table_name_, key, &fields, result);
+    return db.Read(TableName(key_num), key, &fields, result);
   } else {
-    return db.Read(table_name_, key, NULL, result);
+    return db.Read(TableName(key_num), key, NULL, result);
   }
 }
 
 DB::Status CoreWorkload::TransactionReadModifyWrite(DB &db) {
-  uint64_t key_num = NextTransactionKeyNum();
+  uint64_t key_num = NextTransactionKeyNum(key_chooser_);
+  RecordAccess(key_num);
   const std::string key = BuildKeyName(key_num);
   std::vector<DB::Field> result;
 
+  utils::Timer<uint64_t, std::nano> timer;
+  timer.Start();
   if (!read_all_fields()) {
     std::vector<std::string> fields;
     fields.push_back(NextFieldName());
-    db.Read(table_name_, key, &fields, result);
+    db.Read(TableName(key_num), key, &fields, result);
   } else {
-    db.Read(table_name_, key, NULL, result);
+    db.Read(TableName(key_num), key, NULL, result);
   }
 
   std::vector<DB::Field> values;
+  uint32_t version = NextRecordVersion(key_num);
   if (write_all_fields()) {
-    BuildValues(values);
+    BuildValues(key_num, version, values);
   } else {
-    BuildSingleValue(values);
+    BuildSingleValue(key_num, version, values);
+  }
+  DB::Status s = db.Update(TableName(key_num), key, values);
+  if (measurements_) {
+    measurements_->Report(s == DB::kOK ? READMODIFYWRITE : READMODIFYWRITE_FAILED, timer.End());
   }
-  return db.Update(table_name_, key, values);
+  return s;
 }
 
 DB::Status CoreWorkload::TransactionScan(DB &db) {
-  uint64_t key_num = NextTransactionKeyNum();
+  uint64_t key_num = NextTransactionKeyNum(scan_key_chooser_);
+  RecordAccess(key_num);
   const std::string key = BuildKeyName(key_num);
   int len = scan_len_chooser_->Next();
   std::vector<std::vector<DB::Field>> result;
   if (!read_all_fields()) {
     std::vector<std::string> fields;
     fields.push_back(NextFieldName());
-    return db.Scan(table_name_, key, len, &fields, result);
+    return db.Scan(TableName(key_num), key, len, &fields, result);
   } else {
-    return db.Scan(table_name_, key, len, NULL, result);
+    return db.Scan(TableName(key_num), key, len, NULL, result);
   }
 }
 
+DB::Status CoreWorkload::TransactionReverseScan(DB &db) {
+  uint64_t key_num = NextTransactionKeyNum(scan_key_chooser_);
+  RecordAccess(key_num);
+  // the smallest key after the chosen one, so the scan starts at the chosen key
+  const std::string end_key = BuildKeyName(key_num).append(1, '\0');
+  int len = scan_len_chooser_->Next();
+  std::vector<std::vector<DB::Field>> result;
+  DB::Status s;
+  if (!read_all_fields()) {
+    std::vector<std::string> fields;
+    fields.push_back(NextFieldName());
+    s = db.ScanRange(TableName(key_num), "", end_key, len, true, &fields, result);
+  } else {
+    s = db.ScanRange(TableName(key_num), "", end_key, len, true, NULL, result);
+  }
+  if (s == DB::kNotImplemented) {
+    throw utils::Exception("The DB does not support reverse scans");
+  }
+  return s;
+}
+
+DB::Status CoreWorkload::TransactionDeleteRange(DB &db) {
+  uint64_t key_num = NextTransactionKeyNum(key_chooser_);
+  uint64_t len = delete_range_len_chooser_->Next();
+  const std::string start_key = BuildKeyName(key_num);
+  const std::string end_key = BuildKeyName(key_num + len);
+  DB::Status s = db.DeleteRange(TableName(key_num), start_key, end_key);
+  if (s == DB::kNotImplemented) {
+    throw utils::Exception("The DB does not support range deletions");
+  }
+  return s;
+}
+
 DB::Status CoreWorkload::TransactionUpdate(DB &db) {
-  uint64_t key_num = NextTransactionKeyNum();
+  uint64_t key_num = NextTransactionKeyNum(update_key_chooser_);
+  RecordAccess(key_num);
   const std::string key = BuildKeyName(key_num);
   std::vector<DB::Field> values;
+  uint32_t version = NextRecordVersion(key_num);
   if (write_all_fields()) {
-    BuildValues(values);
+    BuildValues(key_num, version, values);
   } else {
-    BuildSingleValue(values);
+    BuildSingleValue(key_num, version, values);
   }
-  return db.Update(table_name_, key, values);
+  return db.Update(TableName(key_num), key, values);
 }
 
 DB::Status CoreWorkload::TransactionInsert(DB &db) {
   uint64_t key_num = transaction_insert_key_sequence_->Next();
   const std::string key = BuildKeyName(key_num);
   std::vector<DB::Field> values;
-  BuildValues(values);
-  DB::Status s = db.Insert(table_name_, key, values);
+  BuildValues(key_num, RecordVersion(key_num), values);
+  RecordAccess(key_num, &values);
+  DB::Status s = db.Insert(TableName(key_num), key, values);
   transaction_insert_key_sequence_->Acknowledge(key_num);
   return s;
 }
 
+Workload *NewCoreWorkload() {
+  return new CoreWorkload;
+}
+
+const bool registered = WorkloadFactory::RegisterWorkload("core", NewCoreWorkload);
+// name used by the workload files shared with the Java YCSB
+const bool registered_java = WorkloadFactory::RegisterWorkload(
+    "com.yahoo.ycsb.workloads.CoreWorkload", NewCoreWorkload);
+
 } // ycsbc
@@ -9,14 +9,19 @@
 #ifndef YCSB_C_CORE_WORKLOAD_H_
 #define YCSB_C_CORE_WORKLOAD_H_
 
+#include <atomic>
 #include <vector>
 #include <string>
 #include "db.h"
+#include "workload.h"
 #include "properties.h"
 #include "generator.h"
 #include "discrete_generator.h"
 #include "counter_generator.h"
 #include "acknowledged_counter_generator.h"
+#include "feistel_permutation.h"
+#include "reuse_distance_analyzer.h"
+#include "hot_key_tracker.h"
 #include "utils.h"
 
 namespace ycsbc {
@@ -28,18 +33,51 @@ enum Operation {
   SCAN,
   READMODIFYWRITE,
   DELETE,
+  INCREMENT,
+  REVERSE_SCAN,
+  DELETE_RANGE,
+  TRANSACTION,
+  COMMIT,
+  FULL_SCAN,
   INSERT_FAILED,
   READ_FAILED,
   UPDATE_FAILED,
   SCAN_FAILED,
   READMODIFYWRITE_FAILED,
   DELETE_FAILED,
+  INCREMENT_FAILED,
+  REVERSE_SCAN_FAILED,
+  DELETE_RANGE_FAILED,
+  TRANSACTION_FAILED,
+  COMMIT_FAILED,
+  FULL_SCAN_FAILED,
+  CACHE_HIT,
+  CACHE_MISS,
   MAXOPTYPE
 };
 
 extern const char *kOperationString[MAXOPTYPE];
 
-class CoreWorkload {
+///
+/// Read-modify-writes and transactions are made of reads and updates, commits
+/// are part of transactions and cache lookups are part of reads, so none of
+/// them adds to the operation totals.
+///
+inline bool IsTotaledOperation(Operation op) {
+  switch (op) {
+    case READMODIFYWRITE:
+    case READMODIFYWRITE_FAILED:
+    case TRANSACTION:
+    case TRANSACTION_FAILED:
+    case COMMIT:
+    case COMMIT_FAILED:
+      return false;
+    default:
+      return op < CACHE_HIT;
+  }
+}
+
+class CoreWorkload : public Workload {
  public:
   ///
   /// The name of the database table to run queries against.
@@ -47,19 +85,61 @@ class CoreWorkload {
   static const std::string TABLENAME_PROPERTY;
   static const std::string TABLENAME_DEFAULT;
 
+  ///
+  /// The name of the property for the number of tables.
+  /// If greater than one, records are spread over tables named
+  /// <table>0 .. <table>N-1 by key number.
+  ///
+  static const std::string TABLE_COUNT_PROPERTY;
+  static const std::string TABLE_COUNT_DEFAULT;
+
   ///
   /// The name of the property for the number of fields in a record.
   ///
   static const std::string FIELD_COUNT_PROPERTY;
   static const std::string FIELD_COUNT_DEFAULT;
 
+  ///
+  /// The name of the property for the distribution of the number of fields
+  /// of a record. A record with k fields has the fields 0 to k-1, k being
+  /// derived from the key. Options are "constant" (always fieldcount),
+  /// "uniform", "zipfian" (favoring few fields) and "empirical".
+  ///
+  static const std::string FIELD_COUNT_DISTRIBUTION_PROPERTY;
+  static const std::string FIELD_COUNT_DISTRIBUTION_DEFAULT;
+  static const std::string FIELD_COUNT_HISTOGRAM_PROPERTY;
+
+  ///
+  /// The name of the property for the distribution of the field read or
+  /// updated by an operation on a single field.
+  /// Options are "uniform", "zipfian" (favoring the first fields) and "empirical".
+  ///
+  static const std::string FIELD_DISTRIBUTION_PROPERTY;
+  static const std::string FIELD_DISTRIBUTION_DEFAULT;
+  static const std::string FIELD_HISTOGRAM_PROPERTY;
+
   ///
   /// The name of the property for the field length distribution.
-  /// Options are "uniform", "zipfian" (favoring short records), and "constant".
+  /// Options are "uniform", "zipfian" (favoring short records), "constant" and "empirical".
   ///
   static const std::string FIELD_LENGTH_DISTRIBUTION_PROPERTY;
   static const std::string FIELD_LENGTH_DISTRIBUTION_DEFAULT;
 
+  ///
+  /// The name of the property for the histogram file of the "empirical" field
+  /// length distribution, with one "length weight" or "min max weight" line per bucket.
+  ///
+  static const std::string FIELD_LENGTH_HISTOGRAM_PROPERTY;
+
+  ///
+  /// The name of the property for the factor applied to the field lengths of a
+  /// record on each update. Field lengths are derived from the key, so with the
+  /// default of 1 a record keeps its size across updates. Otherwise the version of
+  /// every record is kept, 4 bytes a record, and a field growing past 1 MB is an error.
+  ///
+  static const std::string FIELD_LENGTH_GROWTH_PROPERTY;
+  static const std::string FIELD_LENGTH_GROWTH_DEFAULT;
+
   ///
   /// The name of the property for the length of a field in bytes.
   ///
@@ -104,6 +184,23 @@ class CoreWorkload {
   static const std::string SCAN_PROPORTION_PROPERTY;
   static const std::string SCAN_PROPORTION_DEFAULT;
 
+  ///
+  /// The name of the property for the proportion of reverse scan transactions,
+  /// which read the records up to and including the chosen key in reverse order.
+  ///
+  static const std::string REVERSE_SCAN_PROPORTION_PROPERTY;
+  static const std::string REVERSE_SCAN_PROPORTION_DEFAULT;
+
+  ///
+  /// The name of the property for the proportion of range deletion transactions,
+  /// which delete the records from the chosen key on in one operation. Requires
+  /// insertorder=ordered and a zeropadding as wide as recordcount, so the deleted
+  /// keys are contiguous; later reads and scans of them measure the read path
+  /// over the deletions.
+  ///
+  static const std::string DELETE_RANGE_PROPORTION_PROPERTY;
+  static const std::string DELETE_RANGE_PROPORTION_DEFAULT;
+
   ///
   /// The name of the property for the proportion of
   /// read-modify-write transactions.
@@ -113,11 +210,35 @@ class CoreWorkload {
 
   ///
   /// The name of the property for the the distribution of request keys.
-  /// Options are "uniform", "zipfian" and "latest".
+  /// Options are "uniform", "zipfian", "latest", "hotspot" and "empirical".
+  /// With inserts in the transaction phase, "zipfian" covers the inserted keys as well.
+  /// Reads, updates and scans can be given their own distribution with the
+  /// "read.", "update." and "scan." prefixed request distribution, zipfian
+  /// constant and hotspot properties.
   ///
   static const std::string REQUEST_DISTRIBUTION_PROPERTY;
   static const std::string REQUEST_DISTRIBUTION_DEFAULT;
 
+  ///
+  /// The name of the property for the histogram file of the "empirical" request
+  /// distribution. Its values are popularity ranks, 0 being the hottest key.
+  ///
+  static const std::string REQUEST_HISTOGRAM_PROPERTY;
+
+  ///
+  /// The name of the property for the fraction of the keys in the hot set
+  /// of the hotspot distribution.
+  ///
+  static const std::string HOTSPOT_DATA_FRACTION_PROPERTY;
+  static const std::string HOTSPOT_DATA_FRACTION_DEFAULT;
+
+  ///
+  /// The name of the property for the fraction of the operations accessing
+  /// the hot set of the hotspot distribution.
+  ///
+  static const std::string HOTSPOT_OPN_FRACTION_PROPERTY;
+  static const std::string HOTSPOT_OPN_FRACTION_DEFAULT;
+
   ///
   /// The default zero padding value. Matches integer sort order
   ///
@@ -138,11 +259,33 @@ class CoreWorkload {
 
   ///
   /// The name of the property for the scan length distribution.
-  /// Options are "uniform" and "zipfian" (favoring short scans).
+  /// Options are "uniform", "zipfian" (favoring short scans) and "empirical".
   ///
   static const std::string SCAN_LENGTH_DISTRIBUTION_PROPERTY;
   static const std::string SCAN_LENGTH_DISTRIBUTION_DEFAULT;
 
+  ///
+  /// The name of the property for the histogram file of the "empirical" scan
+  /// length distribution.
+  ///
+  static const std::string SCAN_LENGTH_HISTOGRAM_PROPERTY;
+
+  ///
+  /// The names of the properties for the min and max number of key numbers
+  /// covered by a range deletion.
+  ///
+  static const std::string MIN_DELETE_RANGE_LENGTH_PROPERTY;
+  static const std::string MIN_DELETE_RANGE_LENGTH_DEFAULT;
+  static const std::string MAX_DELETE_RANGE_LENGTH_PROPERTY;
+  static const std::string MAX_DELETE_RANGE_LENGTH_DEFAULT;
+
+  ///
+  /// The name of the property for the range deletion length distribution.
+  /// Options are "uniform" and "zipfian" (favoring short ranges).
+  ///
+  static const std::string DELETE_RANGE_LENGTH_DISTRIBUTION_PROPERTY;
+  static const std::string DELETE_RANGE_LENGTH_DISTRIBUTION_DEFAULT;
+
   ///
   /// The name of the property for the order to insert records.
   /// Options are "ordered" or "hashed".
@@ -169,194 +312,127 @@ class CoreWorkload {
   static const std::string ZIPFIAN_CONSTANT_DEFAULT;
 
   ///
-  /// Initialize the scenario.
-  /// Called once, in the main client thread, before any operations are started.
+  /// The name of the property for the fraction of keys sampled to estimate
+  /// the LRU hit ratio curve of the transaction key stream. Zero disables it.
   ///
-  virtual void Init(const utils::Properties &p);
+  static const std::string MRC_SAMPLING_RATE_PROPERTY;
+  static const std::string MRC_SAMPLING_RATE_DEFAULT;
 
-  virtual bool DoInsert(DB &db);
-  virtual bool DoTransaction(DB &db);
+  ///
+  /// The name of the property for the number of hottest transaction keys
+  /// to track and report. Zero disables it.
+  ///
+  static const std::string HOT_KEYS_PROPERTY;
+  static const std::string HOT_KEYS_DEFAULT;
+
+  ///
+  /// The name of the property for the width of the per-thread count-min sketch
+  /// of the hot key tracker.
+  ///
+  static const std::string HOT_KEYS_SKETCH_WIDTH_PROPERTY;
+  static const std::string HOT_KEYS_SKETCH_WIDTH_DEFAULT;
+
+  void Init(const utils::Properties &p) override;
+
+  bool DoInsert(DB &db, ThreadState *state) override;
+  bool DoTransaction(DB &db, ThreadState *state) override;
+
+  void PrintReport(std::ostream &os, const std::string &prefix) override;
 
   bool read_all_fields() const { return read_all_fields_; }
   bool write_all_fields() const { return write_all_fields_; }
 
+  ///
+  /// Returns the key of a key number, permuted with insertorder=hashed.
+  ///
+  std::string BuildKeyName(uint64_t key_num);
+
+  ///
+  /// Returns a sample of the field length distribution, in which the lengths of
+  /// a record's fields are looked up by key hash.
+  ///
+  static std::vector<uint64_t> GetFieldLenSamples(const utils::Properties &p);
+
   CoreWorkload() :
       field_count_(0), read_all_fields_(false), write_all_fields_(false),
-      field_len_generator_(nullptr), key_chooser_(nullptr), field_chooser_(nullptr),
-      scan_len_chooser_(nullptr), insert_key_sequence_(nullptr),
-      transaction_insert_key_sequence_(nullptr), ordered_inserts_(true), record_count_(0) {
+      field_len_growth_(1.0), key_chooser_(nullptr),
+      read_key_chooser_(nullptr), update_key_chooser_(nullptr), scan_key_chooser_(nullptr),
+      field_chooser_(nullptr), scan_len_chooser_(nullptr), delete_range_len_chooser_(nullptr),
+      insert_key_sequence_(nullptr), transaction_insert_key_sequence_(nullptr),
+      ordered_inserts_(true), key_permutation_(0), record_count_(0), reuse_analyzer_(nullptr),
+      hot_keys_(nullptr) {
   }
 
-  virtual ~CoreWorkload() {
-    delete field_len_generator_;
+  ~CoreWorkload() override {
+    for (auto *chooser : {read_key_chooser_, update_key_chooser_, scan_key_chooser_}) {
+      if (chooser != key_chooser_) {
+        delete chooser;
+      }
+    }
     delete key_chooser_;
     delete field_chooser_;
     delete scan_len_chooser_;
+    delete delete_range_len_chooser_;
     delete insert_key_sequence_;
-    delete transaction_insert_key_sequence_;
+    if (transaction_insert_key_sequence_ != nullptr) {
+      AcknowledgedCounterGenerator::Release(table_name_);
+    }
+    delete reuse_analyzer_;
+    delete hot_keys_;
   }
 
  protected:
-  static Generator<uint64_t> *GetFieldLenGenerator(const utils::Properties &p);
-  std::string BuildKeyName(uint64_t key_num);
-  void BuildValues(std::vector<DB::Field> &values);
-  void BuildSingleValue(std::vector<DB::Field> &update);
-
-  uint64_t NextTransactionKeyNum();
-  uint64_t NextReadTransactionKeyNum();
-  uint64_t NextUpdateTransactionKeyNum();
+  Generator<uint64_t> *GetKeyChooser(const utils::Properties &p, const std::string &prefix);
+  const std::string &TableName(uint64_t key_num) const;
+  void BuildValues(uint64_t key_num, uint32_t version, std::vector<DB::Field> &values);
+  void BuildSingleValue(uint64_t key_num, uint32_t version, std::vector<DB::Field> &update);
+  uint64_t FieldLength(uint64_t key_num, int field, uint32_t version) const;
+  int RecordFieldCount(uint64_t key_num) const;
+  uint32_t RecordVersion(uint64_t key_num);
+  uint32_t NextRecordVersion(uint64_t key_num);
+  void RecordAccess(uint64_t key_num, const std::vector<DB::Field> *values = nullptr);
+
+  uint64_t NextTransactionKeyNum(Generator<uint64_t> *chooser);
   std::string NextFieldName();
 
   DB::Status TransactionRead(DB &db);
   DB::Status TransactionReadModifyWrite(DB &db);
   DB::Status TransactionScan(DB &db);
+  DB::Status TransactionReverseScan(DB &db);
+  DB::Status TransactionDeleteRange(DB &db);
   DB::Status TransactionUpdate(DB &db);
   DB::Status TransactionInsert(DB &db);
 
   std::string table_name_;
+  std::vector<std::string> table_names_;
   int field_count_;
   std::string field_prefix_;
   bool read_all_fields_;
   bool write_all_fields_;
-  Generator<uint64_t> *field_len_generator_;
+  std::vector<uint64_t> field_len_samples_;
+  std::vector<uint64_t> field_count_samples_; // empty if every record has field_count_ fields
+  double field_len_growth_;
+  std::vector<std::atomic<uint32_t>> record_versions_; // by key number
   DiscreteGenerator<Operation> op_chooser_;
   Generator<uint64_t> *key_chooser_; // transaction key gen
+  Generator<uint64_t> *read_key_chooser_; // same as key_chooser_ unless overridden
   Generator<uint64_t> *update_key_chooser_;
-  Generator<uint64_t> *read_key_chooser_;
+  Generator<uint64_t> *scan_key_chooser_;
   Generator<uint64_t> *field_chooser_;
   Generator<uint64_t> *scan_len_chooser_;
+  Generator<uint64_t> *delete_range_len_chooser_;
   CounterGenerator *insert_key_sequence_; // load insert key gen
   AcknowledgedCounterGenerator *transaction_insert_key_sequence_; // transaction insert key gen
   bool ordered_inserts_;
+  FeistelPermutation key_permutation_; // spreads key numbers for hashed inserts
   size_t record_count_;
   int zero_padding_;
+  ReuseDistanceAnalyzer *reuse_analyzer_;
+  HotKeyTracker *hot_keys_;
 };
 
-inline uint64_t CoreWorkload::NextTransactionKeyNum() {
-  uint64_t key_num;
-  do {
-    key_num = key_chooser_->Next();
-  } while (key_num > transaction_insert_key_sequence_->Last());
-  return key_num;
-}
-
-inline uint64_t CoreWorkload::NextReadTransactionKeyNum() {
-  uint64_t key_num;
-  do {
-    key_num = read_key_chooser_->Next();
-  } while (key_num > transaction_insert_key_sequence_->Last());
-  return key_num;
-}
-
-inline uint64_t CoreWorkload::NextUpdateTransactionKeyNum() {
-  uint64_t key_num;
-  do {
-    key_num = update_key_chooser_->Next();
-  } while (key_num > transaction_insert_key_sequence_->Last());
-  return key_num;
-}
-
-inline std::string CoreWorkload::NextFieldName() {
-  return std::string(field_prefix_).append(std::to_string(field_chooser_->Next()));
-}
-
-inline bool CoreWorkload::DoInsert(DB &db) {
-  const std::string key = BuildKeyName(insert_key_sequence_->Next());
-  std::vector<DB::Field> fields;
-  BuildValues(fields);
-  return db.Insert(table_name_, key, fields) == DB::kOK;
-}
-
-inline bool CoreWorkload::DoTransaction(DB &db) {
-  int status = -1;
-  switch (op_chooser_.Next()) {
-    case READ:
-      status = TransactionRead(db);
-      break;
-    case UPDATE:
-      status = TransactionUpdate(db);
-      break;
-    case INSERT:
-      status = TransactionInsert(db);
-      break;
-    case SCAN:
-      status = TransactionScan(db);
-      break;
-    case READMODIFYWRITE:
-      status = TransactionReadModifyWrite(db);
-      break;
-    default:
-      throw utils::Exception("Operation request is not recognized!");
-  }
-  assert(status >= 0);
-  return (status == DB::kOK);
-}
-
-inline int CoreWorkload::TransactionRead(DB &db) {
-  uint64_t key_num = NextReadTransactionKeyNum();
-  const std::string key = BuildKeyName(key_num);
-  std::vector<DB::Field> result;
-  if (!read_all_fields()) {
-    std::vector<std::string> fields;
-    fields.push_back(NextFieldName());
-    return db.Read(table_name_, key, &fields, result);
-  } else {
-    return db.Read(table_name_, key, NULL, result);
-  }
-}
-
-inline int CoreWorkload::TransactionReadModifyWrite(DB &db) {
-  uint64_t key_num = NextTransactionKeyNum();
-  const std::string key = BuildKeyName(key_num);
-  std::vector<DB::Field> result;
-
-  if (!read_all_fields()) {
-    std::vector<std::string> fields;
-    fields.push_back(NextFieldName());
-    db.Read(table_name_, key, &fields, result);
-  } else {
-    db.Read(table_name_, key, NULL, result);
-  }
-
-  std::vector<DB::Field> values;
-  if (write_all_fields()) {
-    BuildValues(values);
-  } else {
-    BuildSingleValue(values);
-  }
-  return db.Update(table_name_, key, values);
-}
-
-inline int CoreWorkload::TransactionScan(DB &db) {
-  uint64_t key_num = NextTransactionKeyNum();
-  const std::string key = BuildKeyName(key_num);
-  int len = scan_len_chooser_->Next();
-  std::vector<std::vector<DB::Field>> result;
-  if (!read_all_fields()) {
-    std::vector<std::string> fields;
-    fields.push_back(NextFieldName());
-    return db.Scan(table_name_, key, len, &fields, result);
-  } else {
-    return db.Scan(table_name_, key, len, NULL, result);
-  }
-}
-
-inline int CoreWorkload::TransactionUpdate(DB &db) {
-  uint64_t key_num = NextUpdateTransactionKeyNum();
-  const std::string key = BuildKeyName(key_num);
-  std::vector<DB::Field> values;
-  BuildValues(values);
-  return db.Update(table_name_, key, values);
-}
-
-inline int CoreWorkload::TransactionInsert(DB &db) {
-  uint64_t key_num = transaction_insert_key_sequence_->Next();
-  const std::string key = BuildKeyName(key_num);
-  std::vector<DB::Field> values;
-  BuildValues(values);
-  int s = db.Insert(table_name_, key, values);
-  transaction_insert_key_sequence_->Acknowledge(key_num);
-  return s;
+inline const std::string &CoreWorkload::TableName(uint64_t key_num) const {
+  return table_names_[key_num % table_names_.size()];
 }
 
 } // ycsbc
@@ -0,0 +1,97 @@
+//
+//  count_min_sketch.h
+//  YCSB-cpp
+//
+//  Copyright (c) 2020 Youngjae Lee <ls4154.lee@gmail.com>.
+//
+
+#ifndef YCSB_C_COUNT_MIN_SKETCH_H_
+#define YCSB_C_COUNT_MIN_SKETCH_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace ycsbc {
+
+///
+/// Count-min sketch of kDepth rows of Counter, indexed by a 64-bit hash of
+/// the item. The width is rounded up to a power of two.
+///
+template <typename Counter>
+class CountMinSketch {
+ public:
+  static const int kDepth = 4;
+
+  explicit CountMinSketch(size_t width) {
+    size_t w = 1;
+    while (w < width) {
+      w <<= 1;
+    }
+    mask_ = w - 1;
+    for (auto &row : table_) {
+      row.assign(w, 0);
+    }
+  }
+
+  size_t width() const { return mask_ + 1; }
+
+  ///
+  /// Adds count to the counters of hash, saturating at limit, and returns
+  /// the new estimate.
+  ///
+  uint64_t Add(uint64_t hash, uint64_t count,
+               uint64_t limit = std::numeric_limits<Counter>::max()) {
+    uint64_t estimate = limit;
+    for (int i = 0; i < kDepth; i++) {
+      Counter &counter = table_[i][Index(hash, i)];
+      counter = static_cast<Counter>(std::min<uint64_t>(limit, counter + count));
+      estimate = std::min<uint64_t>(estimate, counter);
+    }
+    return estimate;
+  }
+
+  uint64_t Estimate(uint64_t hash) const {
+    uint64_t estimate = std::numeric_limits<Counter>::max();
+    for (int i = 0; i < kDepth; i++) {
+      estimate = std::min<uint64_t>(estimate, table_[i][Index(hash, i)]);
+    }
+    return estimate;
+  }
+
+  ///
+  /// Adds the counters of a sketch of the same width.
+  ///
+  void Merge(const CountMinSketch &other) {
+    for (int i = 0; i < kDepth; i++) {
+      for (size_t j = 0; j < table_[i].size(); j++) {
+        table_[i][j] += other.table_[i][j];
+      }
+    }
+  }
+
+  void Halve() {
+    for (auto &row : table_) {
+      for (Counter &counter : row) {
+        counter >>= 1;
+      }
+    }
+  }
+
+ private:
+  size_t Index(uint64_t hash, int i) const {
+    static const uint64_t kSeeds[kDepth] = {
+      0xc3a5c85c97cb3127ull, 0xb492b66fbe98f273ull, 0x9ae16a3b2f90404full, 0xcbf29ce484222325ull
+    };
+    uint64_t h = (hash + kSeeds[i]) * kSeeds[(i + 1) % kDepth];
+    return (h ^ (h >> 32)) & mask_;
+  }
+
+  size_t mask_;
+  std::vector<Counter> table_[kDepth];
+};
+
+} // ycsbc
+
+#endif // YCSB_C_COUNT_MIN_SKETCH_H_
@@ -0,0 +1,162 @@
+//
+//  counter_workload.cc
+//  YCSB-cpp
+//
+//  Copyright (c) 2020 Youngjae Lee <ls4154.lee@gmail.com>.
+//
+
+#include "counter_workload.h"
+
+#include <algorithm>
+#include <string>
+#include "uniform_generator.h"
+#include "scrambled_zipfian_generator.h"
+#include "core_workload.h"
+#include "workload_factory.h"
+#include "measurements.h"
+#include "timer.h"
+#include "utils.h"
+
+namespace ycsbc {
+
+namespace {
+
+const std::string kRequestDistributionDefault = "zipfian";
+
+} // anonymous
+
+const std::string CounterWorkload::COUNTER_FIELD_PROPERTY = "counter.field";
+const std::string CounterWorkload::COUNTER_FIELD_DEFAULT = "count";
+
+const std::string CounterWorkload::DELTA_PROPERTY = "counter.delta";
+const std::string CounterWorkload::DELTA_DEFAULT = "1";
+
+const std::string CounterWorkload::RMW_PROPORTION_PROPERTY = "counter.rmwproportion";
+const std::string CounterWorkload::RMW_PROPORTION_DEFAULT = "1";
+
+const std::string CounterWorkload::INCREMENT_PROPORTION_PROPERTY = "counter.incrementproportion";
+const std::string CounterWorkload::INCREMENT_PROPORTION_DEFAULT = "0";
+
+const std::string CounterWorkload::READ_PROPORTION_PROPERTY = "counter.readproportion";
+const std::string CounterWorkload::READ_PROPORTION_DEFAULT = "0";
+
+void CounterWorkload::Init(const utils::Properties &p) {
+  table_name_ = p.GetProperty(CoreWorkload::TABLENAME_PROPERTY, CoreWorkload::TABLENAME_DEFAULT);
+  field_name_ = p.GetProperty(COUNTER_FIELD_PROPERTY, COUNTER_FIELD_DEFAULT);
+  delta_ = std::stoull(p.GetProperty(DELTA_PROPERTY, DELTA_DEFAULT));
+
+  counter_count_ = std::stoull(p.GetProperty(CoreWorkload::RECORD_COUNT_PROPERTY));
+  if (counter_count_ == 0) {
+    throw utils::Exception("recordcount must be positive");
+  }
+  counter_digits_ = std::to_string(counter_count_ - 1).size();
+
+  double rmw_proportion = std::stod(p.GetProperty(RMW_PROPORTION_PROPERTY,
+                                                  RMW_PROPORTION_DEFAULT));
+  double increment_proportion = std::stod(p.GetProperty(INCREMENT_PROPORTION_PROPERTY,
+                                                        INCREMENT_PROPORTION_DEFAULT));
+  double read_proportion = std::stod(p.GetProperty(READ_PROPORTION_PROPERTY,
+                                                   READ_PROPORTION_DEFAULT));
+  if (rmw_proportion > 0) {
+    op_chooser_.AddValue(RMW_INCREMENT, rmw_proportion);
+  }
+  if (increment_proportion > 0) {
+    op_chooser_.AddValue(INCREMENT_OP, increment_proportion);
+  }
+  if (read_proportion > 0) {
+    op_chooser_.AddValue(READ_COUNTER, read_proportion);
+  }
+
+  std::string request_dist = p.GetProperty(CoreWorkload::REQUEST_DISTRIBUTION_PROPERTY,
+                                           kRequestDistributionDefault);
+  if (request_dist == "uniform") {
+    key_chooser_ = new UniformGenerator(0, counter_count_ - 1);
+  } else if (request_dist == "zipfian") {
+    key_chooser_ = new ScrambledZipfianGenerator(counter_count_, ZipfianGenerator::kZipfianConst);
+  } else {
+    throw utils::Exception("Unknown request distribution: " + request_dist);
+  }
+
+  insert_key_sequence_ = new CounterGenerator(std::stoull(
+      p.GetProperty(CoreWorkload::INSERT_START_PROPERTY, CoreWorkload::INSERT_START_DEFAULT)));
+}
+
+std::string CounterWorkload::CounterKey(uint64_t counter) const {
+  std::string counter_num = std::to_string(counter);
+  std::string key("counter");
+  key.append(counter_digits_ - std::min<size_t>(counter_digits_, counter_num.size()), '0');
+  return key.append(counter_num);
+}
+
+bool CounterWorkload::DoInsert(DB &db, ThreadState *state) {
+  std::vector<DB::Field> values;
+  values.push_back(DB::Field{field_name_, utils::EncodeFixed64(0)});
+  return db.Insert(table_name_, CounterKey(insert_key_sequence_->Next()), values) == DB::kOK;
+}
+
+bool CounterWorkload::DoTransaction(DB &db, ThreadState *state) {
+  if (op_chooser_.Empty()) {
+    throw utils::Exception("All operation proportions are zero");
+  }
+  DB::Status status;
+  switch (op_chooser_.Next()) {
+    case RMW_INCREMENT:
+      status = ReadModifyWriteIncrement(db);
+      break;
+    case INCREMENT_OP:
+      status = Increment(db);
+      break;
+    case READ_COUNTER:
+      status = ReadCounter(db);
+      break;
+    default:
+      throw utils::Exception("Operation request is not recognized!");
+  }
+  return (status == DB::kOK);
+}
+
+DB::Status CounterWorkload::ReadModifyWriteIncrement(DB &db) {
+  const std::string key = CounterKey(key_chooser_->Next());
+  std::vector<std::string> fields(1, field_name_);
+  std::vector<DB::Field> result;
+
+  utils::Timer<uint64_t, std::nano> timer;
+  timer.Start();
+  // not atomic: concurrent increments of a hot counter may be lost
+  DB::Status s = db.Read(table_name_, key, &fields, result);
+  if (s == DB::kOK) {
+    uint64_t count = result.empty() ? 0 : utils::DecodeFixed64(result[0].value);
+    std::vector<DB::Field> values;
+    values.push_back(DB::Field{field_name_, utils::EncodeFixed64(count + delta_)});
+    s = db.Update(table_name_, key, values);
+  }
+  if (measurements_) {
+    measurements_->Report(s == DB::kOK ? READMODIFYWRITE : READMODIFYWRITE_FAILED, timer.End());
+  }
+  return s;
+}
+
+DB::Status CounterWorkload::Increment(DB &db) {
+  std::vector<DB::Field> deltas;
+  deltas.push_back(DB::Field{field_name_, utils::EncodeFixed64(delta_)});
+  DB::Status s = db.Increment(table_name_, CounterKey(key_chooser_->Next()), deltas);
+  if (s == DB::kNotImplemented) {
+    throw utils::Exception("The DB does not support Increment; for rocksdb, build with "
+                           "USE_MERGEUPDATE and leave rocksdb.mergeupdate unset");
+  }
+  return s;
+}
+
+DB::Status CounterWorkload::ReadCounter(DB &db) {
+  std::vector<std::string> fields(1, field_name_);
+  std::vector<DB::Field> result;
+  return db.Read(table_name_, CounterKey(key_chooser_->Next()), &fields, result);
+}
+
+Workload *NewCounterWorkload() {
+  return new CounterWorkload;
+}
+
+const bool registered = WorkloadFactory::RegisterWorkload("counter", NewCounterWorkload);
+
+} // ycsbc
@@ -0,0 +1,94 @@
+//
+//  counter_workload.h
+//  YCSB-cpp
+//
+//  Copyright (c) 2020 Youngjae Lee <ls4154.lee@gmail.com>.
+//
+
+#ifndef YCSB_C_COUNTER_WORKLOAD_H_
+#define YCSB_C_COUNTER_WORKLOAD_H_
+
+#include <string>
+#include <vector>
+#include "db.h"
+#include "workload.h"
+#include "properties.h"
+#include "generator.h"
+#include "discrete_generator.h"
+#include "counter_generator.h"
+
+namespace ycsbc {
+
+///
+/// Small numeric counters incremented on skewed keys, as kept for rate limits
+/// and analytics. Each record has a single 8-byte counter field. Increments
+/// are done either as a read and an update of the counter, measured as
+/// READMODIFYWRITE, or as a single DB::Increment, measured as INCREMENT
+/// (a merge in RocksDB), so the two variants can be compared in one run.
+/// Uses the table and requestdistribution properties of the core workload.
+///
+class CounterWorkload : public Workload {
+ public:
+  ///
+  /// The name of the property for the name of the counter field.
+  ///
+  static const std::string COUNTER_FIELD_PROPERTY;
+  static const std::string COUNTER_FIELD_DEFAULT;
+
+  ///
+  /// The name of the property for the amount added by each increment.
+  ///
+  static const std::string DELTA_PROPERTY;
+  static const std::string DELTA_DEFAULT;
+
+  ///
+  /// The names of the properties for the proportions of read-modify-write
+  /// increments, single-operation increments and reads of a counter.
+  ///
+  static const std::string RMW_PROPORTION_PROPERTY;
+  static const std::string RMW_PROPORTION_DEFAULT;
+  static const std::string INCREMENT_PROPORTION_PROPERTY;
+  static const std::string INCREMENT_PROPORTION_DEFAULT;
+  static const std::string READ_PROPORTION_PROPERTY;
+  static const std::string READ_PROPORTION_DEFAULT;
+
+  void Init(const utils::Properties &p) override;
+
+  bool DoInsert(DB &db, ThreadState *state) override;
+  bool DoTransaction(DB &db, ThreadState *state) override;
+
+  CounterWorkload() :
+      counter_count_(0), delta_(0), key_chooser_(nullptr), insert_key_sequence_(nullptr) {
+  }
+
+  ~CounterWorkload() override {
+    delete key_chooser_;
+    delete insert_key_sequence_;
+  }
+
+ private:
+  enum CounterOperation {
+    RMW_INCREMENT = 0,
+    INCREMENT_OP,
+    READ_COUNTER
+  };
+
+  std::string CounterKey(uint64_t counter) const;
+
+  DB::Status ReadModifyWriteIncrement(DB &db);
+  DB::Status Increment(DB &db);
+  DB::Status ReadCounter(DB &db);
+
+  std::string table_name_;
+  std::string field_name_;
+  uint64_t counter_count_;
+  int counter_digits_;
+  uint64_t delta_;
+  DiscreteGenerator<CounterOperation> op_chooser_;
+  Generator<uint64_t> *key_chooser_;
+  CounterGenerator *insert_key_sequence_;
+};
+
+} // ycsbc
+
+#endif // YCSB_C_COUNTER_WORKLOAD_H_
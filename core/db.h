@@ -11,6 +11,8 @@
 
 #include "properties.h"
 
+#include <cstdint>
+#include <map>
 #include <vector>
 #include <string>
 
@@ -30,7 +32,8 @@ class DB {
     kOK = 0,
     kError,
     kNotFound,
-    kNotImplemented
+    kNotImplemented,
+    kAborted
   };
   ///
   /// Initializes any state for accessing this DB.
@@ -69,6 +72,43 @@ class DB {
                    int record_count, const std::vector<std::string> *fields,
                    std::vector<std::vector<Field>> &result) = 0;
   ///
+  /// Performs a range scan bounded by keys, forward or backward.
+  /// Reads the records with start_key <= key < end_key, in key order or, if
+  /// reverse, in reverse key order starting below end_key.
+  ///
+  /// @param table The name of the table.
+  /// @param start_key The smallest key to read, or "" for no lower bound.
+  /// @param end_key The key after the largest key to read, or "" for no upper bound.
+  /// @param record_count The maximum number of records to read.
+  /// @param reverse Whether to read from the largest key down.
+  /// @param fields The list of fields to read, or NULL for all of them.
+  /// @param result A vector of vector, where each vector contains field/value
+  ///        pairs for one record
+  /// @return Zero on success, kNotImplemented if the DB has no such operation.
+  ///
+  virtual Status ScanRange(const std::string &table, const std::string &start_key,
+                           const std::string &end_key, int record_count, bool reverse,
+                           const std::vector<std::string> *fields,
+                           std::vector<std::vector<Field>> &result) {
+    return kNotImplemented;
+  }
+  ///
+  /// Reads through all records with start_key <= key < end_key with one
+  /// iterator, as an export of the table or of a partition of it does,
+  /// without returning them.
+  ///
+  /// @param table The name of the table.
+  /// @param start_key The smallest key to read, or "" for no lower bound.
+  /// @param end_key The key after the largest key to read, or "" for no upper bound.
+  /// @param records The number of records read.
+  /// @param bytes The number of key and value bytes read.
+  /// @return Zero on success, kNotImplemented if the DB has no such operation.
+  ///
+  virtual Status FullScan(const std::string &table, const std::string &start_key,
+                          const std::string &end_key, uint64_t &records, uint64_t &bytes) {
+    return kNotImplemented;
+  }
+  ///
   /// Updates a record in the database.
   /// Field/value pairs in the specified vector are written to the record,
   /// overwriting any existing values with the same field names.
@@ -99,6 +139,86 @@ class DB {
   /// @return Zero on success, a non-zero error code on error.
   ///
   virtual Status Delete(const std::string &table, const std::string &key) = 0;
+  ///
+  /// Deletes the records with keys in [start_key, end_key) from the database.
+  ///
+  /// @param table The name of the table.
+  /// @param start_key The first key of the range.
+  /// @param end_key The key past the end of the range.
+  /// @return Zero on success, kNotImplemented if the DB has no such operation.
+  ///
+  virtual Status DeleteRange(const std::string &table, const std::string &start_key,
+                             const std::string &end_key) {
+    return kNotImplemented;
+  }
+  ///
+  /// Adds to counters of a record in the database in one operation.
+  /// Counter values are 8-byte little-endian unsigned integers (see
+  /// utils::EncodeFixed64); a missing record or field counts as zero.
+  ///
+  /// @param table The name of the table.
+  /// @param key The key of the record to add to.
+  /// @param deltas A vector of field/delta pairs, the deltas encoded like the values.
+  /// @return Zero on success, kNotImplemented if the DB has no such operation.
+  ///
+  virtual Status Increment(const std::string &table, const std::string &key,
+                           std::vector<Field> &deltas) {
+    return kNotImplemented;
+  }
+
+  ///
+  /// Starts a transaction of the calling thread. Until Commit or Rollback, its
+  /// reads and writes are part of the transaction, and reads lock the records
+  /// (or, in optimistic transactions, have them validated at commit).
+  /// Reads and writes return kAborted on a conflict with another transaction,
+  /// which the caller then ends with Rollback.
+  ///
+  /// @return Zero on success, kNotImplemented if the DB has no transactions.
+  ///
+  virtual Status Begin() {
+    return kNotImplemented;
+  }
+  ///
+  /// Commits the transaction. The transaction ends even if the commit fails.
+  ///
+  /// @return Zero on success, kAborted on a conflict.
+  ///
+  virtual Status Commit() {
+    return kNotImplemented;
+  }
+  ///
+  /// Discards the writes of the transaction. Does nothing if it has ended.
+  ///
+  virtual Status Rollback() {
+    return kNotImplemented;
+  }
+
+  ///
+  /// Takes a long-lived read view of the database, such as a snapshot or a
+  /// read transaction, pinning the current versions of the records until
+  /// ReleaseSnapshot, as a long-running reader does. Replaces a view already held.
+  ///
+  /// @return Zero on success, kNotImplemented if the DB has no such operation.
+  ///
+  virtual Status HoldSnapshot() {
+    return kNotImplemented;
+  }
+  ///
+  /// Releases the read view taken by HoldSnapshot, if any.
+  ///
+  virtual Status ReleaseSnapshot() {
+    return kNotImplemented;
+  }
+  ///
+  /// Reports the space used by the database, such as the size of its files or
+  /// of its free pages, by engine-specific name in bytes or counts.
+  ///
+  /// @param stats The map the figures are added to.
+  /// @return Zero on success, kNotImplemented if the DB has no such operation.
+  ///
+  virtual Status GetSpaceStats(std::map<std::string, uint64_t> &stats) {
+    return kNotImplemented;
+  }
 
   virtual ~DB() { }
 
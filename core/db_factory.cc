@@ -9,6 +9,7 @@
 #include "db_factory.h"
 #include "basic_db.h"
 #include "db_wrapper.h"
+#include "cache_db.h"
 
 namespace ycsbc {
 
@@ -30,6 +31,11 @@ DB *DBFactory::CreateDB(utils::Properties *props, Measurements *measurements) {
   if (registry.find(db_name) != registry.end()) {
     DB *new_db = (*registry[db_name])();
     new_db->SetProps(props);
+    if (std::stoul(props->GetProperty(CacheDB::CACHE_SIZE_PROPERTY,
+                                      CacheDB::CACHE_SIZE_DEFAULT)) > 0) {
+      new_db = new CacheDB(new_db, measurements);
+      new_db->SetProps(props);
+    }
     db = new DBWrapper(new_db, measurements);
   }
   return db;
@@ -54,6 +54,20 @@ class DBWrapper : public DB {
     }
     return s;
   }
+  Status ScanRange(const std::string &table, const std::string &start_key,
+                   const std::string &end_key, int record_count, bool reverse,
+                   const std::vector<std::string> *fields,
+                   std::vector<std::vector<Field>> &result) {
+    timer_.Start();
+    Status s = db_->ScanRange(table, start_key, end_key, record_count, reverse, fields, result);
+    uint64_t elapsed = timer_.End();
+    if (s == kOK) {
+      measurements_->Report(reverse ? REVERSE_SCAN : SCAN, elapsed);
+    } else {
+      measurements_->Report(reverse ? REVERSE_SCAN_FAILED : SCAN_FAILED, elapsed);
+    }
+    return s;
+  }
   Status Update(const std::string &table, const std::string &key, std::vector<Field> &values) {
     timer_.Start();
     Status s = db_->Update(table, key, values);
@@ -87,6 +101,67 @@ class DBWrapper : public DB {
     }
     return s;
   }
+  Status Begin() {
+    return db_->Begin();
+  }
+  Status Commit() {
+    timer_.Start();
+    Status s = db_->Commit();
+    uint64_t elapsed = timer_.End();
+    if (s == kOK) {
+      measurements_->Report(COMMIT, elapsed);
+    } else {
+      measurements_->Report(COMMIT_FAILED, elapsed);
+    }
+    return s;
+  }
+  Status Rollback() {
+    return db_->Rollback();
+  }
+  Status HoldSnapshot() {
+    return db_->HoldSnapshot();
+  }
+  Status ReleaseSnapshot() {
+    return db_->ReleaseSnapshot();
+  }
+  Status GetSpaceStats(std::map<std::string, uint64_t> &stats) {
+    return db_->GetSpaceStats(stats);
+  }
+  Status FullScan(const std::string &table, const std::string &start_key,
+                  const std::string &end_key, uint64_t &records, uint64_t &bytes) {
+    timer_.Start();
+    Status s = db_->FullScan(table, start_key, end_key, records, bytes);
+    uint64_t elapsed = timer_.End();
+    if (s == kOK) {
+      measurements_->Report(FULL_SCAN, elapsed);
+    } else {
+      measurements_->Report(FULL_SCAN_FAILED, elapsed);
+    }
+    return s;
+  }
+  Status DeleteRange(const std::string &table, const std::string &start_key,
+                     const std::string &end_key) {
+    timer_.Start();
+    Status s = db_->DeleteRange(table, start_key, end_key);
+    uint64_t elapsed = timer_.End();
+    if (s == kOK) {
+      measurements_->Report(DELETE_RANGE, elapsed);
+    } else {
+      measurements_->Report(DELETE_RANGE_FAILED, elapsed);
+    }
+    return s;
+  }
+  Status Increment(const std::string &table, const std::string &key, std::vector<Field> &deltas) {
+    timer_.Start();
+    Status s = db_->Increment(table, key, deltas);
+    uint64_t elapsed = timer_.End();
+    if (s == kOK) {
+      measurements_->Report(INCREMENT, elapsed);
+    } else {
+      measurements_->Report(INCREMENT_FAILED, elapsed);
+    }
+    return s;
+  }
  private:
   DB *db_;
   Measurements *measurements_;
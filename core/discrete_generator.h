@@ -26,6 +26,7 @@ class DiscreteGenerator : public Generator<Value> {
 
   Value Next();
   Value Last() { return last_; }
+  bool Empty() const { return values_.empty(); }
 
  private:
   std::vector<std::pair<Value, double>> values_;
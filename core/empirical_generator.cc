@@ -0,0 +1,126 @@
+//
+//  empirical_generator.cc
+//  YCSB-cpp
+//
+//  Copyright (c) 2020 Youngjae Lee <ls4154.lee@gmail.com>.
+//
+
+#include "empirical_generator.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+namespace ycsbc {
+
+EmpiricalGenerator::EmpiricalGenerator(const std::vector<Bucket> &buckets) {
+  double total = 0;
+  for (const Bucket &bucket : buckets) {
+    if (bucket.weight < 0 || bucket.low > bucket.high) {
+      throw utils::Exception("Invalid histogram bucket");
+    }
+    if (bucket.weight > 0) {
+      buckets_.push_back(bucket);
+      total += bucket.weight;
+    }
+  }
+  if (buckets_.empty()) {
+    throw utils::Exception("Empty histogram");
+  }
+
+  double sum = 0;
+  for (const Bucket &bucket : buckets_) {
+    sum += bucket.weight;
+    cumulative_.push_back(sum / total);
+  }
+
+  min_ = buckets_[0].low;
+  max_ = buckets_[0].high;
+  for (const Bucket &bucket : buckets_) {
+    min_ = std::min(min_, bucket.low);
+    max_ = std::max(max_, bucket.high);
+  }
+
+  // Vose's alias method
+  size_t n = buckets_.size();
+  prob_.resize(n);
+  alias_.resize(n);
+  std::vector<double> scaled(n);
+  std::vector<uint32_t> small, large;
+  for (size_t i = 0; i < n; i++) {
+    scaled[i] = buckets_[i].weight * n / total;
+    (scaled[i] < 1.0 ? small : large).push_back(i);
+  }
+  while (!small.empty() && !large.empty()) {
+    uint32_t s = small.back();
+    uint32_t l = large.back();
+    small.pop_back();
+    prob_[s] = scaled[s];
+    alias_[s] = l;
+    scaled[l] -= 1.0 - scaled[s];
+    if (scaled[l] < 1.0) {
+      large.pop_back();
+      small.push_back(l);
+    }
+  }
+  // left-overs are 1 up to rounding
+  for (uint32_t i : large) {
+    prob_[i] = 1.0;
+    alias_[i] = i;
+  }
+  for (uint32_t i : small) {
+    prob_[i] = 1.0;
+    alias_[i] = i;
+  }
+
+  Next();
+}
+
+uint64_t EmpiricalGenerator::ValueAt(double u) const {
+  size_t i = std::upper_bound(cumulative_.begin(), cumulative_.end(), u) - cumulative_.begin();
+  if (i >= buckets_.size()) {
+    i = buckets_.size() - 1;
+  }
+  const Bucket &bucket = buckets_[i];
+  double start = i == 0 ? 0 : cumulative_[i - 1];
+  double position = (u - start) / (cumulative_[i] - start);
+  uint64_t offset = std::max(0.0, position) * (bucket.high - bucket.low + 1);
+  return std::min(bucket.high, bucket.low + offset);
+}
+
+std::vector<EmpiricalGenerator::Bucket> EmpiricalGenerator::LoadBuckets(
+    const std::string &filename) {
+  std::ifstream input(filename);
+  if (!input) {
+    throw utils::Exception("Cannot open histogram file: " + filename);
+  }
+  std::vector<Bucket> buckets;
+  std::string line;
+  while (std::getline(input, line)) {
+    line = utils::Trim(line);
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+    std::istringstream fields(line);
+    std::vector<std::string> tokens;
+    std::string token;
+    while (fields >> token) {
+      tokens.push_back(token);
+    }
+    try {
+      if (tokens.size() == 2) {
+        uint64_t value = std::stoull(tokens[0]);
+        buckets.push_back({value, value, std::stod(tokens[1])});
+      } else if (tokens.size() == 3) {
+        buckets.push_back({std::stoull(tokens[0]), std::stoull(tokens[1]), std::stod(tokens[2])});
+      } else {
+        throw utils::Exception("");
+      }
+    } catch (const std::exception &e) {
+      throw utils::Exception("Invalid line in histogram file " + filename + ": " + line);
+    }
+  }
+  return buckets;
+}
+
+} // ycsbc
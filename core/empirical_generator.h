@@ -0,0 +1,108 @@
+//
+//  empirical_generator.h
+//  YCSB-cpp
+//
+//  Copyright (c) 2020 Youngjae Lee <ls4154.lee@gmail.com>.
+//
+
+#ifndef YCSB_C_EMPIRICAL_GENERATOR_H_
+#define YCSB_C_EMPIRICAL_GENERATOR_H_
+
+#include "generator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "feistel_permutation.h"
+#include "utils.h"
+
+namespace ycsbc {
+
+///
+/// Samples a histogram in O(1) with an alias table. Each bucket covers the
+/// values [low, high], which are uniform within the bucket.
+///
+class EmpiricalGenerator : public Generator<uint64_t> {
+ public:
+  struct Bucket {
+    uint64_t low;
+    uint64_t high;
+    double weight;
+  };
+
+  explicit EmpiricalGenerator(const std::vector<Bucket> &buckets);
+
+  ///
+  /// Reads the buckets from a file with one "value weight" or "low high weight"
+  /// line per bucket. Empty lines and lines starting with '#' are skipped.
+  ///
+  static std::vector<Bucket> LoadBuckets(const std::string &filename);
+
+  uint64_t Next();
+  uint64_t Last() { return last_; }
+
+  uint64_t Min() const { return min_; }
+  uint64_t Max() const { return max_; }
+
+  ///
+  /// Returns the value at quantile u of [0, 1) of the histogram, e.g. to
+  /// sample it at fixed quantiles.
+  ///
+  uint64_t ValueAt(double u) const;
+
+ protected:
+  uint64_t Sample() const;
+
+  std::atomic<uint64_t> last_;
+
+ private:
+  std::vector<Bucket> buckets_;
+  std::vector<double> prob_;
+  std::vector<uint32_t> alias_;
+  std::vector<double> cumulative_; /// Share of the weight up to the end of each bucket
+  uint64_t min_;
+  uint64_t max_;
+};
+
+///
+/// Takes the values of the histogram as popularity ranks and permutes them
+/// over [0, num_items), so that the popular keys are spread over the keyspace.
+/// Ranks past the range wrap around.
+///
+class ScrambledEmpiricalGenerator : public EmpiricalGenerator {
+ public:
+  ScrambledEmpiricalGenerator(const std::vector<Bucket> &buckets, uint64_t num_items) :
+      EmpiricalGenerator(buckets), num_items_(num_items), permutation_(num_items) {
+    Next();
+  }
+
+  uint64_t Next() { return last_ = permutation_.Permute(Sample() % num_items_); }
+
+ private:
+  const uint64_t num_items_;
+  const FeistelPermutation permutation_;
+};
+
+inline uint64_t EmpiricalGenerator::Sample() const {
+  size_t column = utils::ThreadLocalRandomDouble() * prob_.size();
+  if (column >= prob_.size()) {
+    column = prob_.size() - 1;
+  }
+  const Bucket &bucket = buckets_[utils::ThreadLocalRandomDouble() < prob_[column] ?
+                                  column : alias_[column]];
+  if (bucket.low == bucket.high) {
+    return bucket.low;
+  }
+  uint64_t offset = utils::ThreadLocalRandomDouble() * (bucket.high - bucket.low + 1);
+  return std::min(bucket.high, bucket.low + offset);
+}
+
+inline uint64_t EmpiricalGenerator::Next() {
+  return last_ = Sample();
+}
+
+} // ycsbc
+
+#endif // YCSB_C_EMPIRICAL_GENERATOR_H_
@@ -0,0 +1,107 @@
+//
+//  feistel_permutation.h
+//  YCSB-cpp
+//
+//  Copyright (c) 2020 Youngjae Lee <ls4154.lee@gmail.com>.
+//
+
+#ifndef YCSB_C_FEISTEL_PERMUTATION_H_
+#define YCSB_C_FEISTEL_PERMUTATION_H_
+
+#include <cstdint>
+
+namespace ycsbc {
+
+///
+/// Pseudo-random bijection over [0, num_items), or over all 64-bit values if
+/// num_items is zero. A balanced Feistel network permutes the smallest even
+/// number of bits covering the range; values falling outside the range are
+/// encrypted again (cycle-walking), which takes less than four rounds of the
+/// network on average.
+///
+class FeistelPermutation {
+ public:
+  explicit FeistelPermutation(uint64_t num_items, uint64_t seed = 0) : num_items_(num_items) {
+    int bits = 64;
+    if (num_items != 0) {
+      bits = 2;
+      while (bits < 64 && ((num_items - 1) >> bits) != 0) {
+        bits += 2;
+      }
+    }
+    half_bits_ = bits / 2;
+    half_mask_ = (uint64_t{1} << half_bits_) - 1;
+    uint64_t state = seed;
+    for (uint64_t &key : keys_) {
+      key = SplitMix64(state);
+    }
+  }
+
+  ///
+  /// Maps value, which must be in range, to its image.
+  ///
+  uint64_t Permute(uint64_t value) const {
+    do {
+      value = Encrypt(value);
+    } while (num_items_ != 0 && value >= num_items_);
+    return value;
+  }
+
+  ///
+  /// Maps an image back to the value it was computed from.
+  ///
+  uint64_t Invert(uint64_t value) const {
+    do {
+      value = Decrypt(value);
+    } while (num_items_ != 0 && value >= num_items_);
+    return value;
+  }
+
+ private:
+  static const int kRounds = 4;
+
+  static uint64_t SplitMix64(uint64_t &state) {
+    uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+  }
+
+  uint64_t Round(uint64_t half, int round) const {
+    uint64_t x = (half ^ keys_[round]) * 0xbf58476d1ce4e5b9ull;
+    x ^= x >> 31;
+    x *= 0x94d049bb133111ebull;
+    return (x ^ (x >> 29)) & half_mask_;
+  }
+
+  uint64_t Encrypt(uint64_t value) const {
+    uint64_t left = value >> half_bits_;
+    uint64_t right = value & half_mask_;
+    for (int i = 0; i < kRounds; i++) {
+      uint64_t next = left ^ Round(right, i);
+      left = right;
+      right = next;
+    }
+    return (left << half_bits_) | right;
+  }
+
+  uint64_t Decrypt(uint64_t value) const {
+    uint64_t left = value >> half_bits_;
+    uint64_t right = value & half_mask_;
+    for (int i = kRounds - 1; i >= 0; i--) {
+      uint64_t prev = right ^ Round(left, i);
+      right = left;
+      left = prev;
+    }
+    return (left << half_bits_) | right;
+  }
+
+  const uint64_t num_items_;
+  int half_bits_;
+  uint64_t half_mask_;
+  uint64_t keys_[kRounds];
+};
+
+} // ycsbc
+
+#endif // YCSB_C_FEISTEL_PERMUTATION_H_
@@ -0,0 +1,110 @@
+//
+//  full_scan_workload.cc
+//  YCSB-cpp
+//
+//  Copyright (c) 2020 Youngjae Lee <ls4154.lee@gmail.com>.
+//
+
+#include "full_scan_workload.h"
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include "workload_factory.h"
+#include "utils.h"
+
+namespace ycsbc {
+
+namespace {
+
+const uint64_t kSamplesPerPartition = 4096;
+
+} // anonymous
+
+const std::string FullScanWorkload::PARTITIONS_PROPERTY = "fullscan.partitions";
+
+void FullScanWorkload::Init(const utils::Properties &p) {
+  loader_.SetMeasurements(measurements_);
+  loader_.Init(p);
+
+  const std::string table_name = p.GetProperty(CoreWorkload::TABLENAME_PROPERTY,
+                                               CoreWorkload::TABLENAME_DEFAULT);
+  int table_count = std::stoi(p.GetProperty(CoreWorkload::TABLE_COUNT_PROPERTY,
+                                            CoreWorkload::TABLE_COUNT_DEFAULT));
+  if (table_count == 1) {
+    table_names_.push_back(table_name);
+  } else {
+    for (int i = 0; i < table_count; i++) {
+      table_names_.push_back(table_name + std::to_string(i));
+    }
+  }
+
+  uint64_t partitions = std::stoull(p.GetProperty(PARTITIONS_PROPERTY,
+                                                  p.GetProperty("threadcount", "1")));
+  if (partitions == 0) {
+    throw utils::Exception("fullscan.partitions must be positive");
+  }
+  // the bounds are quantiles of the keys of evenly spaced key numbers, which are the even
+  // split of the key numbers in ordered order and a pseudo-random sample in hashed order
+  uint64_t record_count = std::stoull(p.GetProperty(CoreWorkload::RECORD_COUNT_PROPERTY));
+  uint64_t samples = std::min(record_count, partitions * kSamplesPerPartition);
+  std::vector<std::string> keys;
+  for (uint64_t i = 0; i < samples; i++) {
+    keys.push_back(loader_.BuildKeyName(record_count * i / samples));
+  }
+  std::sort(keys.begin(), keys.end());
+  for (uint64_t i = 1; i < partitions && samples > 0; i++) {
+    bounds_.push_back(keys[i * samples / partitions]);
+  }
+}
+
+uint64_t FullScanWorkload::NowNanos() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool FullScanWorkload::DoInsert(DB &db, ThreadState *state) {
+  return loader_.DoInsert(db, state);
+}
+
+bool FullScanWorkload::DoTransaction(DB &db, ThreadState *state) {
+  const uint64_t partitions = bounds_.size() + 1;
+  uint64_t range = next_range_.fetch_add(1) % (partitions * table_names_.size());
+  const std::string &table = table_names_[range / partitions];
+  uint64_t partition = range % partitions;
+  const std::string start_key = partition == 0 ? "" : bounds_[partition - 1];
+  const std::string end_key = partition == partitions - 1 ? "" : bounds_[partition];
+
+  uint64_t unset = 0;
+  start_ns_.compare_exchange_strong(unset, NowNanos());
+  uint64_t records = 0;
+  uint64_t bytes = 0;
+  DB::Status s = db.FullScan(table, start_key, end_key, records, bytes);
+  if (s == DB::kNotImplemented) {
+    throw utils::Exception("The DB does not support full scans");
+  }
+  records_.fetch_add(records, std::memory_order_relaxed);
+  bytes_.fetch_add(bytes, std::memory_order_relaxed);
+  uint64_t now = NowNanos();
+  uint64_t end = end_ns_.load();
+  while (end < now && !end_ns_.compare_exchange_weak(end, now)) {
+  }
+  return s == DB::kOK;
+}
+
+void FullScanWorkload::PrintReport(std::ostream &os, const std::string &prefix) {
+  uint64_t records = records_.load();
+  double mbytes = bytes_.load() / 1048576.0;
+  double sec = (end_ns_.load() - start_ns_.load()) / 1e9;
+  os << prefix << "Full scan: " << records << " records, " << mbytes << " MB in " << sec
+     << " sec (" << (sec > 0 ? records / sec : 0) << " records/sec, "
+     << (sec > 0 ? mbytes / sec : 0) << " MB/sec)" << std::endl;
+}
+
+Workload *NewFullScanWorkload() {
+  return new FullScanWorkload;
+}
+
+const bool registered = WorkloadFactory::RegisterWorkload("fullscan", NewFullScanWorkload);
+
+} // ycsbc
@@ -0,0 +1,69 @@
+//
+//  full_scan_workload.h
+//  YCSB-cpp
+//
+//  Copyright (c) 2020 Youngjae Lee <ls4154.lee@gmail.com>.
+//
+
+#ifndef YCSB_C_FULL_SCAN_WORKLOAD_H_
+#define YCSB_C_FULL_SCAN_WORKLOAD_H_
+
+#include <atomic>
+#include <string>
+#include <vector>
+#include "db.h"
+#include "workload.h"
+#include "properties.h"
+#include "core_workload.h"
+
+namespace ycsbc {
+
+///
+/// Sequential read throughput of a full-table scan, such as a nightly export.
+/// The key space of every table is split into fullscan.partitions ranges, and
+/// each operation reads through one range with a single iterator or cursor,
+/// so concurrent threads scan different ranges. Ranges are taken in turn, one
+/// pass over all tables taking fullscan.partitions times tablecount operations
+/// and further operations starting over. Scans are measured as FULLSCAN, and
+/// the report gives the records and megabytes read per second. The load phase
+/// is that of the core workload, and the range bounds are quantiles of a
+/// sorted sample of its keys, so ranges hold about as many records whatever
+/// the insert order and zero padding.
+///
+class FullScanWorkload : public Workload {
+ public:
+  ///
+  /// The name of the property for the number of ranges of a table, by
+  /// default the number of threads.
+  ///
+  static const std::string PARTITIONS_PROPERTY;
+
+  void Init(const utils::Properties &p) override;
+
+  bool DoInsert(DB &db, ThreadState *state) override;
+  bool DoTransaction(DB &db, ThreadState *state) override;
+
+  void PrintReport(std::ostream &os, const std::string &prefix) override;
+
+  FullScanWorkload() :
+      next_range_(0), records_(0), bytes_(0), start_ns_(0), end_ns_(0) {
+  }
+
+ private:
+  static uint64_t NowNanos();
+
+  CoreWorkload loader_;
+  std::vector<std::string> table_names_;
+  // the boundaries between consecutive ranges, in key order
+  std::vector<std::string> bounds_;
+  std::atomic<uint64_t> next_range_;
+  std::atomic<uint64_t> records_;
+  std::atomic<uint64_t> bytes_;
+  // the start of the first scan and the end of the last one
+  std::atomic<uint64_t> start_ns_;
+  std::atomic<uint64_t> end_ns_;
+};
+
+} // ycsbc
+
+#endif // YCSB_C_FULL_SCAN_WORKLOAD_H_
@@ -0,0 +1,377 @@
+//
+//  graph_workload.cc
+//  YCSB-cpp
+//
+//  Copyright (c) 2020 Youngjae Lee <ls4154.lee@gmail.com>.
+//
+
+#include "graph_workload.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <set>
+#include <string>
+#include <utility>
+#include "uniform_generator.h"
+#include "zipfian_generator.h"
+#include "scrambled_zipfian_generator.h"
+#include "random_byte_generator.h"
+#include "core_workload.h"
+#include "workload_factory.h"
+#include "utils.h"
+
+namespace ycsbc {
+
+namespace {
+
+const size_t kDegreeSamples = 1 << 16;
+
+std::string RandomBytes(size_t len) {
+  std::string bytes;
+  bytes.reserve(len);
+  RandomByteGenerator byte_generator;
+  std::generate_n(std::back_inserter(bytes), len, [&]() { return byte_generator.Next(); } );
+  return bytes;
+}
+
+std::string Now() {
+  using namespace std::chrono;
+  return std::to_string(duration_cast<milliseconds>(system_clock::now().time_since_epoch())
+                        .count());
+}
+
+} // anonymous
+
+const std::string GraphWorkload::NODE_TABLE_PROPERTY = "graph.nodetable";
+const std::string GraphWorkload::NODE_TABLE_DEFAULT = "nodetable";
+
+const std::string GraphWorkload::EDGE_TABLE_PROPERTY = "graph.edgetable";
+const std::string GraphWorkload::EDGE_TABLE_DEFAULT = "edgetable";
+
+const std::string GraphWorkload::COUNT_TABLE_PROPERTY = "graph.counttable";
+const std::string GraphWorkload::COUNT_TABLE_DEFAULT = "counttable";
+
+const std::string GraphWorkload::EDGE_TYPES_PROPERTY = "graph.edgetypes";
+const std::string GraphWorkload::EDGE_TYPES_DEFAULT = "2";
+
+const std::string GraphWorkload::MAX_DEGREE_PROPERTY = "graph.maxdegree";
+const std::string GraphWorkload::MAX_DEGREE_DEFAULT = "100";
+
+const std::string GraphWorkload::NODE_DISTRIBUTION_PROPERTY = "graph.nodedistribution";
+const std::string GraphWorkload::NODE_DISTRIBUTION_DEFAULT = "zipfian";
+
+const std::string GraphWorkload::RANGE_LIMIT_PROPERTY = "graph.rangelimit";
+const std::string GraphWorkload::RANGE_LIMIT_DEFAULT = "10";
+
+const std::string GraphWorkload::NODE_DATA_SIZE_PROPERTY = "graph.nodedatasize";
+const std::string GraphWorkload::NODE_DATA_SIZE_DEFAULT = "128";
+
+const std::string GraphWorkload::EDGE_DATA_SIZE_PROPERTY = "graph.edgedatasize";
+const std::string GraphWorkload::EDGE_DATA_SIZE_DEFAULT = "32";
+
+const std::string GraphWorkload::GET_NODE_PROPORTION_PROPERTY = "graph.getnodeproportion";
+const std::string GraphWorkload::GET_NODE_PROPORTION_DEFAULT = "0.129";
+
+const std::string GraphWorkload::UPDATE_NODE_PROPORTION_PROPERTY = "graph.updatenodeproportion";
+const std::string GraphWorkload::UPDATE_NODE_PROPORTION_DEFAULT = "0.074";
+
+const std::string GraphWorkload::ADD_EDGE_PROPORTION_PROPERTY = "graph.addedgeproportion";
+const std::string GraphWorkload::ADD_EDGE_PROPORTION_DEFAULT = "0.09";
+
+const std::string GraphWorkload::DELETE_EDGE_PROPORTION_PROPERTY = "graph.deleteedgeproportion";
+const std::string GraphWorkload::DELETE_EDGE_PROPORTION_DEFAULT = "0.03";
+
+const std::string GraphWorkload::UPDATE_EDGE_PROPORTION_PROPERTY = "graph.updateedgeproportion";
+const std::string GraphWorkload::UPDATE_EDGE_PROPORTION_DEFAULT = "0.08";
+
+const std::string GraphWorkload::COUNT_EDGES_PROPORTION_PROPERTY = "graph.countedgesproportion";
+const std::string GraphWorkload::COUNT_EDGES_PROPORTION_DEFAULT = "0.049";
+
+const std::string GraphWorkload::GET_EDGE_RANGE_PROPORTION_PROPERTY =
+    "graph.getedgerangeproportion";
+const std::string GraphWorkload::GET_EDGE_RANGE_PROPORTION_DEFAULT = "0.548";
+
+void GraphWorkload::Init(const utils::Properties &p) {
+  node_table_ = p.GetProperty(NODE_TABLE_PROPERTY, NODE_TABLE_DEFAULT);
+  edge_table_ = p.GetProperty(EDGE_TABLE_PROPERTY, EDGE_TABLE_DEFAULT);
+  count_table_ = p.GetProperty(COUNT_TABLE_PROPERTY, COUNT_TABLE_DEFAULT);
+
+  node_count_ = std::stoull(p.GetProperty(CoreWorkload::RECORD_COUNT_PROPERTY));
+  if (node_count_ == 0) {
+    throw utils::Exception("The graph workload needs a positive recordcount");
+  }
+  node_digits_ = std::to_string(node_count_ - 1).size();
+  edge_types_ = std::stoi(p.GetProperty(EDGE_TYPES_PROPERTY, EDGE_TYPES_DEFAULT));
+  if (edge_types_ < 1) {
+    throw utils::Exception("graph.edgetypes must be positive");
+  }
+  range_limit_ = std::stoi(p.GetProperty(RANGE_LIMIT_PROPERTY, RANGE_LIMIT_DEFAULT));
+  node_data_size_ = std::stoul(p.GetProperty(NODE_DATA_SIZE_PROPERTY, NODE_DATA_SIZE_DEFAULT));
+  edge_data_size_ = std::stoul(p.GetProperty(EDGE_DATA_SIZE_PROPERTY, EDGE_DATA_SIZE_DEFAULT));
+
+  // a node's out-degree is looked up by node hash in a sample of the distribution
+  uint64_t max_degree = std::stoull(p.GetProperty(MAX_DEGREE_PROPERTY, MAX_DEGREE_DEFAULT));
+  ZipfianGenerator degree_generator(0, max_degree);
+  degree_samples_.resize(kDegreeSamples);
+  for (uint64_t &degree : degree_samples_) {
+    degree = degree_generator.Next();
+  }
+
+  const std::pair<GraphOperation, double> proportions[] = {
+    {GET_NODE, std::stod(p.GetProperty(GET_NODE_PROPORTION_PROPERTY,
+                                       GET_NODE_PROPORTION_DEFAULT))},
+    {UPDATE_NODE, std::stod(p.GetProperty(UPDATE_NODE_PROPORTION_PROPERTY,
+                                          UPDATE_NODE_PROPORTION_DEFAULT))},
+    {ADD_EDGE, std::stod(p.GetProperty(ADD_EDGE_PROPORTION_PROPERTY,
+                                       ADD_EDGE_PROPORTION_DEFAULT))},
+    {DELETE_EDGE, std::stod(p.GetProperty(DELETE_EDGE_PROPORTION_PROPERTY,
+                                          DELETE_EDGE_PROPORTION_DEFAULT))},
+    {UPDATE_EDGE, std::stod(p.GetProperty(UPDATE_EDGE_PROPORTION_PROPERTY,
+                                          UPDATE_EDGE_PROPORTION_DEFAULT))},
+    {COUNT_EDGES, std::stod(p.GetProperty(COUNT_EDGES_PROPORTION_PROPERTY,
+                                          COUNT_EDGES_PROPORTION_DEFAULT))},
+    {GET_EDGE_RANGE, std::stod(p.GetProperty(GET_EDGE_RANGE_PROPORTION_PROPERTY,
+                                             GET_EDGE_RANGE_PROPORTION_DEFAULT))},
+  };
+  for (const auto &proportion : proportions) {
+    if (proportion.second > 0) {
+      op_chooser_.AddValue(proportion.first, proportion.second);
+    }
+  }
+
+  std::string node_dist = p.GetProperty(NODE_DISTRIBUTION_PROPERTY, NODE_DISTRIBUTION_DEFAULT);
+  if (node_dist == "uniform") {
+    node_chooser_ = new UniformGenerator(0, node_count_ - 1);
+    dst_chooser_ = new UniformGenerator(0, node_count_ - 1);
+  } else if (node_dist == "zipfian") {
+    // popular sources are popular destinations as well
+    node_chooser_ = new ScrambledZipfianGenerator(node_count_, ZipfianGenerator::kZipfianConst);
+    dst_chooser_ = new ScrambledZipfianGenerator(node_count_, ZipfianGenerator::kZipfianConst);
+  } else {
+    throw utils::Exception("Unknown node distribution: " + node_dist);
+  }
+
+  insert_node_sequence_ = new CounterGenerator(std::stoull(
+      p.GetProperty(CoreWorkload::INSERT_START_PROPERTY, CoreWorkload::INSERT_START_DEFAULT)));
+}
+
+std::string GraphWorkload::NodeId(uint64_t node) const {
+  std::string num = std::to_string(node);
+  return std::string(node_digits_ - std::min<size_t>(node_digits_, num.size()), '0').append(num);
+}
+
+std::string GraphWorkload::NodeKey(uint64_t node) const {
+  return "node" + NodeId(node);
+}
+
+std::string GraphWorkload::EdgePrefix(uint64_t src, int type) const {
+  return "edge" + NodeId(src) + ':' + std::to_string(type) + ':';
+}
+
+std::string GraphWorkload::EdgeKey(uint64_t src, int type, uint64_t dst) const {
+  return EdgePrefix(src, type) + NodeId(dst);
+}
+
+std::string GraphWorkload::CountKey(uint64_t src, int type) const {
+  return "count" + NodeId(src) + ':' + std::to_string(type);
+}
+
+void GraphWorkload::BuildNode(std::vector<DB::Field> &values) const {
+  values.push_back({"time", Now()});
+  values.push_back({"data", RandomBytes(node_data_size_)});
+}
+
+void GraphWorkload::BuildEdge(uint64_t src, int type, uint64_t dst,
+                              std::vector<DB::Field> &values) const {
+  values.push_back({"id1", std::to_string(src)});
+  values.push_back({"type", std::to_string(type)});
+  values.push_back({"id2", std::to_string(dst)});
+  values.push_back({"time", Now()});
+  values.push_back({"data", RandomBytes(edge_data_size_)});
+}
+
+int GraphWorkload::NextEdgeType() const {
+  return utils::ThreadLocalRandomInt() % edge_types_;
+}
+
+DB::Status GraphWorkload::AdjustCount(DB &db, uint64_t src, int type, int64_t delta) {
+  const std::string key = CountKey(src, type);
+  std::vector<DB::Field> result;
+  const std::vector<std::string> fields = {"count"};
+  DB::Status s = db.Read(count_table_, key, &fields, result);
+  if (s != DB::kOK && s != DB::kNotFound) {
+    return s;
+  }
+  int64_t count = 0;
+  for (const DB::Field &field : result) {
+    if (field.name == "count") {
+      count = std::stoll(field.value);
+    }
+  }
+  std::vector<DB::Field> values = {{"count", std::to_string(std::max<int64_t>(0, count + delta))}};
+  if (s == DB::kNotFound) {
+    return db.Insert(count_table_, key, values);
+  }
+  return db.Update(count_table_, key, values);
+}
+
+bool GraphWorkload::DoInsert(DB &db, ThreadState *state) {
+  uint64_t node = insert_node_sequence_->Next();
+  std::vector<DB::Field> values;
+  BuildNode(values);
+  bool ok = db.Insert(node_table_, NodeKey(node), values) == DB::kOK;
+
+  // distinct edges, inserted in key order
+  uint64_t degree = degree_samples_[utils::Hash(node) % degree_samples_.size()];
+  std::set<std::pair<int, uint64_t>> edges;
+  for (uint64_t i = 0; i < degree; i++) {
+    edges.emplace(NextEdgeType(), dst_chooser_->Next());
+  }
+  std::vector<uint64_t> counts(edge_types_);
+  for (const auto &edge : edges) {
+    values.clear();
+    BuildEdge(node, edge.first, edge.second, values);
+    ok = db.Insert(edge_table_, EdgeKey(node, edge.first, edge.second), values) == DB::kOK && ok;
+    counts[edge.first]++;
+  }
+  for (int type = 0; type < edge_types_; type++) {
+    if (counts[type] > 0) {
+      values = {{"count", std::to_string(counts[type])}};
+      ok = db.Insert(count_table_, CountKey(node, type), values) == DB::kOK && ok;
+    }
+  }
+  return ok;
+}
+
+bool GraphWorkload::DoTransaction(DB &db, ThreadState *state) {
+  if (op_chooser_.Empty()) {
+    throw utils::Exception("All operation proportions are zero");
+  }
+  DB::Status status;
+  switch (op_chooser_.Next()) {
+    case GET_NODE:
+      status = GetNode(db);
+      break;
+    case UPDATE_NODE:
+      status = UpdateNode(db);
+      break;
+    case ADD_EDGE:
+      status = AddEdge(db);
+      break;
+    case DELETE_EDGE:
+      status = DeleteEdge(db);
+      break;
+    case UPDATE_EDGE:
+      status = UpdateEdge(db);
+      break;
+    case COUNT_EDGES:
+      status = CountEdges(db);
+      break;
+    case GET_EDGE_RANGE:
+      status = GetEdgeRange(db);
+      break;
+    default:
+      throw utils::Exception("Operation request is not recognized!");
+  }
+  return (status == DB::kOK);
+}
+
+DB::Status GraphWorkload::GetNode(DB &db) {
+  std::vector<DB::Field> result;
+  return db.Read(node_table_, NodeKey(node_chooser_->Next()), NULL, result);
+}
+
+DB::Status GraphWorkload::UpdateNode(DB &db) {
+  std::vector<DB::Field> values;
+  BuildNode(values);
+  return db.Update(node_table_, NodeKey(node_chooser_->Next()), values);
+}
+
+DB::Status GraphWorkload::AddEdge(DB &db) {
+  uint64_t src = node_chooser_->Next();
+  int type = NextEdgeType();
+  uint64_t dst = dst_chooser_->Next();
+  const std::string key = EdgeKey(src, type, dst);
+  std::vector<DB::Field> result;
+  const std::vector<std::string> fields = {"id2"};
+  DB::Status s = db.Read(edge_table_, key, &fields, result);
+  std::vector<DB::Field> values;
+  BuildEdge(src, type, dst, values);
+  if (s == DB::kOK) {
+    // the edge exists, refresh it
+    return db.Update(edge_table_, key, values);
+  } else if (s != DB::kNotFound) {
+    return s;
+  }
+  s = db.Insert(edge_table_, key, values);
+  if (s != DB::kOK) {
+    return s;
+  }
+  return AdjustCount(db, src, type, 1);
+}
+
+DB::Status GraphWorkload::DeleteEdge(DB &db) {
+  uint64_t src = node_chooser_->Next();
+  int type = NextEdgeType();
+  const std::string key = EdgeKey(src, type, dst_chooser_->Next());
+  std::vector<DB::Field> result;
+  const std::vector<std::string> fields = {"id2"};
+  DB::Status s = db.Read(edge_table_, key, &fields, result);
+  if (s == DB::kNotFound) {
+    return DB::kOK; // nothing to delete
+  } else if (s != DB::kOK) {
+    return s;
+  }
+  s = db.Delete(edge_table_, key);
+  if (s != DB::kOK) {
+    return s;
+  }
+  return AdjustCount(db, src, type, -1);
+}
+
+DB::Status GraphWorkload::UpdateEdge(DB &db) {
+  uint64_t src = node_chooser_->Next();
+  int type = NextEdgeType();
+  uint64_t dst = dst_chooser_->Next();
+  const std::string key = EdgeKey(src, type, dst);
+  std::vector<DB::Field> result;
+  const std::vector<std::string> fields = {"id2"};
+  DB::Status s = db.Read(edge_table_, key, &fields, result);
+  if (s == DB::kNotFound) {
+    return DB::kOK; // nothing to update
+  } else if (s != DB::kOK) {
+    return s;
+  }
+  std::vector<DB::Field> values;
+  BuildEdge(src, type, dst, values);
+  return db.Update(edge_table_, key, values);
+}
+
+DB::Status GraphWorkload::CountEdges(DB &db) {
+  std::vector<DB::Field> result;
+  DB::Status s = db.Read(count_table_, CountKey(node_chooser_->Next(), NextEdgeType()), NULL,
+                         result);
+  return s == DB::kNotFound ? DB::kOK : s; // no edges of the type
+}
+
+DB::Status GraphWorkload::GetEdgeRange(DB &db) {
+  // the edges of (src, type) are the keys with its prefix, which ends in ':'
+  std::string prefix = EdgePrefix(node_chooser_->Next(), NextEdgeType());
+  std::string end_key = prefix;
+  end_key.back() = ':' + 1;
+  std::vector<std::vector<DB::Field>> result;
+  DB::Status s = db.ScanRange(edge_table_, prefix, end_key, range_limit_, false, NULL, result);
+  if (s == DB::kNotImplemented) {
+    throw utils::Exception("The DB does not support range-bounded scans");
+  }
+  return s;
+}
+
+Workload *NewGraphWorkload() {
+  return new GraphWorkload;
+}
+
+const bool registered = WorkloadFactory::RegisterWorkload("graph", NewGraphWorkload);
+
+} // ycsbc
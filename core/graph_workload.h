@@ -0,0 +1,167 @@
+//
+//  graph_workload.h
+//  YCSB-cpp
+//
+//  Copyright (c) 2020 Youngjae Lee <ls4154.lee@gmail.com>.
+//
+
+#ifndef YCSB_C_GRAPH_WORKLOAD_H_
+#define YCSB_C_GRAPH_WORKLOAD_H_
+
+#include <string>
+#include <vector>
+#include "db.h"
+#include "workload.h"
+#include "properties.h"
+#include "generator.h"
+#include "discrete_generator.h"
+#include "counter_generator.h"
+
+namespace ycsbc {
+
+///
+/// Social graph in the style of LinkBench. Nodes, edges keyed by
+/// (src, type, dst) and per-(src, type) edge counts are kept in three tables
+/// with distinct key prefixes, so the edges of a node are adjacent in key order.
+/// The load phase inserts recordcount nodes, each with a power-law number of
+/// out-edges to skewed destinations. The transaction phase picks source nodes
+/// from the node distribution, so hot vertices see most of the traffic.
+///
+class GraphWorkload : public Workload {
+ public:
+  enum GraphOperation {
+    GET_NODE = 0,
+    UPDATE_NODE,
+    ADD_EDGE,
+    DELETE_EDGE,
+    UPDATE_EDGE,
+    COUNT_EDGES,
+    GET_EDGE_RANGE
+  };
+
+  ///
+  /// The names of the properties for the tables of nodes, edges and edge counts.
+  ///
+  static const std::string NODE_TABLE_PROPERTY;
+  static const std::string NODE_TABLE_DEFAULT;
+  static const std::string EDGE_TABLE_PROPERTY;
+  static const std::string EDGE_TABLE_DEFAULT;
+  static const std::string COUNT_TABLE_PROPERTY;
+  static const std::string COUNT_TABLE_DEFAULT;
+
+  ///
+  /// The name of the property for the number of edge types.
+  ///
+  static const std::string EDGE_TYPES_PROPERTY;
+  static const std::string EDGE_TYPES_DEFAULT;
+
+  ///
+  /// The name of the property for the maximum out-degree of a node at load time.
+  /// Out-degrees are zipfian over [0, maxdegree], favoring low degrees.
+  ///
+  static const std::string MAX_DEGREE_PROPERTY;
+  static const std::string MAX_DEGREE_DEFAULT;
+
+  ///
+  /// The name of the property for the distribution of the nodes operated on and
+  /// of the destinations of new edges. Options are "uniform" and "zipfian".
+  ///
+  static const std::string NODE_DISTRIBUTION_PROPERTY;
+  static const std::string NODE_DISTRIBUTION_DEFAULT;
+
+  ///
+  /// The name of the property for the maximum number of edges returned by
+  /// get-edge-range.
+  ///
+  static const std::string RANGE_LIMIT_PROPERTY;
+  static const std::string RANGE_LIMIT_DEFAULT;
+
+  ///
+  /// The names of the properties for the payload sizes of nodes and edges in bytes.
+  ///
+  static const std::string NODE_DATA_SIZE_PROPERTY;
+  static const std::string NODE_DATA_SIZE_DEFAULT;
+  static const std::string EDGE_DATA_SIZE_PROPERTY;
+  static const std::string EDGE_DATA_SIZE_DEFAULT;
+
+  ///
+  /// The names of the properties for the operation mix. The defaults follow
+  /// the LinkBench mix, with node inserts and deletes folded into get-edge-range.
+  ///
+  static const std::string GET_NODE_PROPORTION_PROPERTY;
+  static const std::string GET_NODE_PROPORTION_DEFAULT;
+  static const std::string UPDATE_NODE_PROPORTION_PROPERTY;
+  static const std::string UPDATE_NODE_PROPORTION_DEFAULT;
+  static const std::string ADD_EDGE_PROPORTION_PROPERTY;
+  static const std::string ADD_EDGE_PROPORTION_DEFAULT;
+  static const std::string DELETE_EDGE_PROPORTION_PROPERTY;
+  static const std::string DELETE_EDGE_PROPORTION_DEFAULT;
+  static const std::string UPDATE_EDGE_PROPORTION_PROPERTY;
+  static const std::string UPDATE_EDGE_PROPORTION_DEFAULT;
+  static const std::string COUNT_EDGES_PROPORTION_PROPERTY;
+  static const std::string COUNT_EDGES_PROPORTION_DEFAULT;
+  static const std::string GET_EDGE_RANGE_PROPORTION_PROPERTY;
+  static const std::string GET_EDGE_RANGE_PROPORTION_DEFAULT;
+
+  void Init(const utils::Properties &p) override;
+
+  bool DoInsert(DB &db, ThreadState *state) override;
+  bool DoTransaction(DB &db, ThreadState *state) override;
+
+  GraphWorkload() :
+      node_count_(0), edge_types_(0), range_limit_(0), node_data_size_(0), edge_data_size_(0),
+      node_chooser_(nullptr), dst_chooser_(nullptr), insert_node_sequence_(nullptr) {
+  }
+
+  ~GraphWorkload() override {
+    delete node_chooser_;
+    delete dst_chooser_;
+    delete insert_node_sequence_;
+  }
+
+ private:
+  std::string NodeId(uint64_t node) const;
+  std::string NodeKey(uint64_t node) const;
+  ///
+  /// Returns the prefix shared by the edges of a node of a type.
+  ///
+  std::string EdgePrefix(uint64_t src, int type) const;
+  std::string EdgeKey(uint64_t src, int type, uint64_t dst) const;
+  std::string CountKey(uint64_t src, int type) const;
+  void BuildNode(std::vector<DB::Field> &values) const;
+  void BuildEdge(uint64_t src, int type, uint64_t dst, std::vector<DB::Field> &values) const;
+  int NextEdgeType() const;
+
+  ///
+  /// Adds delta to the edge count of (src, type). The read and the update are
+  /// not atomic, so concurrent writers to the same node may lose increments.
+  ///
+  DB::Status AdjustCount(DB &db, uint64_t src, int type, int64_t delta);
+
+  DB::Status GetNode(DB &db);
+  DB::Status UpdateNode(DB &db);
+  DB::Status AddEdge(DB &db);
+  DB::Status DeleteEdge(DB &db);
+  DB::Status UpdateEdge(DB &db);
+  DB::Status CountEdges(DB &db);
+  DB::Status GetEdgeRange(DB &db);
+
+  std::string node_table_;
+  std::string edge_table_;
+  std::string count_table_;
+  uint64_t node_count_;
+  int node_digits_;
+  int edge_types_;
+  int range_limit_;
+  size_t node_data_size_;
+  size_t edge_data_size_;
+  std::vector<uint64_t> degree_samples_;
+  DiscreteGenerator<GraphOperation> op_chooser_;
+  Generator<uint64_t> *node_chooser_;
+  Generator<uint64_t> *dst_chooser_;
+  CounterGenerator *insert_node_sequence_;
+};
+
+} // ycsbc
+
+#endif // YCSB_C_GRAPH_WORKLOAD_H_
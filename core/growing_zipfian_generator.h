@@ -0,0 +1,150 @@
+//
+//  growing_zipfian_generator.h
+//  YCSB-cpp
+//
+//  Copyright (c) 2020 Youngjae Lee <ls4154.lee@gmail.com>.
+//
+
+#ifndef YCSB_C_GROWING_ZIPFIAN_GENERATOR_H_
+#define YCSB_C_GROWING_ZIPFIAN_GENERATOR_H_
+
+#include "generator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include "counter_generator.h"
+#include "feistel_permutation.h"
+#include "utils.h"
+
+namespace ycsbc {
+
+///
+/// Zipfian distribution over the keys [0, basis.Last()] of a growing keyspace.
+/// The ranks of the initial num_items keys are permuted as in the scrambled
+/// zipfian generator, keys inserted later take the ranks in insertion order.
+/// Each thread extends its own copy of zeta as the keyspace grows, so there is
+/// no shared state written on Next().
+/// NextRank() exposes the unscrambled ranks for other generators.
+///
+class GrowingZipfianGenerator : public Generator<uint64_t> {
+ public:
+  GrowingZipfianGenerator(CounterGenerator &basis, uint64_t num_items, double zipfian_const) :
+      basis_(basis), num_items_(num_items), theta_(zipfian_const),
+      alpha_(1.0 / (1.0 - zipfian_const)), zeta_2_(Zeta(0, 2, zipfian_const, 0)),
+      zeta_base_(Zeta(0, num_items, zipfian_const, 0)), permutation_(num_items),
+      id_(NextId()) {
+    Next();
+  }
+
+  uint64_t Next();
+  uint64_t Last() { return last_; }
+
+  ///
+  /// Returns a rank in [0, num), rank 0 being the most popular.
+  ///
+  uint64_t NextRank(uint64_t num);
+
+ private:
+  struct ThreadState {
+    uint64_t count_for_zeta;
+    double zeta_n;
+    double eta;
+  };
+
+  static uint64_t NextId() {
+    static std::atomic<uint64_t> next_id(0);
+    return next_id.fetch_add(1);
+  }
+
+  ///
+  /// Adds the terms (last_num, cur_num] to last_zeta. The terms past kExactTerms
+  /// are approximated by the integral of x^-theta around them (midpoint rule) in
+  /// O(1). This overestimates the sum by less than theta/24 * 1024.5^-(theta+1)
+  /// in absolute terms, about 4e-8 for theta = 0.99, or 1e-8 of zeta.
+  ///
+  static double Zeta(uint64_t last_num, uint64_t cur_num, double theta, double last_zeta) {
+    const uint64_t kExactTerms = 1024;
+    double zeta = last_zeta;
+    uint64_t i = last_num + 1;
+    for (; i <= cur_num && i <= kExactTerms; ++i) {
+      zeta += 1 / std::pow(i, theta);
+    }
+    if (i <= cur_num) {
+      double from = i - 0.5;
+      double to = cur_num + 0.5;
+      if (theta == 1.0) {
+        zeta += std::log(to / from);
+      } else {
+        zeta += (std::pow(to, 1 - theta) - std::pow(from, 1 - theta)) / (1 - theta);
+      }
+    }
+    return zeta;
+  }
+
+  double Eta(uint64_t num, double zeta_n) const {
+    return (1 - std::pow(2.0 / num, 1 - theta_)) / (1 - zeta_2_ / zeta_n);
+  }
+
+  ThreadState &LocalState(uint64_t num);
+
+  CounterGenerator &basis_;
+  const uint64_t num_items_;
+  const double theta_;
+  const double alpha_;
+  const double zeta_2_;
+  const double zeta_base_;
+  const FeistelPermutation permutation_;
+  const uint64_t id_;
+  std::atomic<uint64_t> last_;
+};
+
+inline GrowingZipfianGenerator::ThreadState &GrowingZipfianGenerator::LocalState(uint64_t num) {
+  // keyed by id, so a new generator at a reused address starts afresh
+  static thread_local std::unordered_map<uint64_t, ThreadState> states;
+  auto it = states.find(id_);
+  if (it == states.end()) {
+    ThreadState initial = {num_items_, zeta_base_, Eta(num_items_, zeta_base_)};
+    it = states.emplace(id_, initial).first;
+  }
+  ThreadState &state = it->second;
+  if (num != state.count_for_zeta) {
+    if (num > state.count_for_zeta) {
+      state.zeta_n = Zeta(state.count_for_zeta, num, theta_, state.zeta_n);
+    } else if (num >= num_items_) {
+      state.zeta_n = Zeta(num_items_, num, theta_, zeta_base_);
+    } else {
+      state.zeta_n = Zeta(0, num, theta_, 0);
+    }
+    state.count_for_zeta = num;
+    state.eta = Eta(num, state.zeta_n);
+  }
+  return state;
+}
+
+inline uint64_t GrowingZipfianGenerator::NextRank(uint64_t num) {
+  ThreadState &state = LocalState(num);
+  double u = utils::ThreadLocalRandomDouble();
+  double uz = u * state.zeta_n;
+  if (uz < 1.0) {
+    return 0;
+  }
+  if (uz < 1.0 + std::pow(0.5, theta_)) {
+    return 1;
+  }
+  return std::min<uint64_t>(num - 1, num * std::pow(state.eta * u - state.eta + 1, alpha_));
+}
+
+inline uint64_t GrowingZipfianGenerator::Next() {
+  uint64_t rank = NextRank(std::max<uint64_t>(2, basis_.Last() + 1));
+  if (rank < num_items_) {
+    return last_ = permutation_.Permute(rank);
+  }
+  return last_ = rank;
+}
+
+} // ycsbc
+
+#endif // YCSB_C_GROWING_ZIPFIAN_GENERATOR_H_
@@ -0,0 +1,111 @@
+//
+//  hot_key_tracker.cc
+//  YCSB-cpp
+//
+//  Copyright (c) 2020 Youngjae Lee <ls4154.lee@gmail.com>.
+//
+
+#include "hot_key_tracker.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+#include "utils.h"
+
+namespace ycsbc {
+
+namespace {
+
+std::atomic<uint64_t> next_tracker_id(0);
+
+} // anonymous
+
+HotKeyTracker::HotKeyTracker(size_t top_k, size_t sketch_width)
+    : top_k_(std::max<size_t>(1, top_k)), sketch_width_(sketch_width),
+      id_(next_tracker_id.fetch_add(1)) { }
+
+HotKeyTracker::Shard *HotKeyTracker::LocalShard() {
+  // trackers are told apart by id, so a new tracker at a reused address starts afresh
+  static thread_local std::unordered_map<uint64_t, Shard *> local_shards;
+  Shard *&shard = local_shards[id_];
+  if (shard == nullptr) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    shards_.emplace_back(new Shard(sketch_width_));
+    shard = shards_.back().get();
+  }
+  return shard;
+}
+
+void HotKeyTracker::Access(uint64_t key_num) {
+  Shard &shard = *LocalShard();
+  shard.total++;
+  uint64_t estimate = shard.sketch.Add(utils::Hash(key_num), 1);
+
+  auto it = shard.top.find(key_num);
+  if (it != shard.top.end()) {
+    shard.by_count.erase({it->second, key_num});
+    it->second = estimate;
+    shard.by_count.insert({estimate, key_num});
+    return;
+  }
+  if (shard.top.size() >= top_k_) {
+    auto coldest = shard.by_count.begin();
+    if (coldest->first >= estimate) {
+      return;
+    }
+    shard.top.erase(coldest->second);
+    shard.by_count.erase(coldest);
+  }
+  shard.top[key_num] = estimate;
+  shard.by_count.insert({estimate, key_num});
+}
+
+std::vector<HotKeyTracker::HotKey> HotKeyTracker::TopKeys(uint64_t *total) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Sketch merged(sketch_width_);
+  std::vector<uint64_t> candidates;
+  *total = 0;
+  for (const auto &shard : shards_) {
+    merged.Merge(shard->sketch);
+    *total += shard->total;
+    for (const auto &kv : shard->top) {
+      candidates.push_back(kv.first);
+    }
+  }
+  std::sort(candidates.begin(), candidates.end());
+  candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+  std::vector<HotKey> keys;
+  for (uint64_t key_num : candidates) {
+    keys.push_back({key_num, merged.Estimate(utils::Hash(key_num))});
+  }
+  std::sort(keys.begin(), keys.end(), [](const HotKey &a, const HotKey &b) {
+    return a.count > b.count || (a.count == b.count && a.key_num < b.key_num);
+  });
+  if (keys.size() > top_k_) {
+    keys.resize(top_k_);
+  }
+  return keys;
+}
+
+double HotKeyTracker::EstimateSkew(const std::vector<HotKey> &keys) {
+  // fit log(count) = c - s * log(rank)
+  double n = 0, sum_x = 0, sum_y = 0, sum_xx = 0, sum_xy = 0;
+  for (size_t i = 0; i < keys.size() && keys[i].count > 0; i++) {
+    double x = std::log(static_cast<double>(i + 1));
+    double y = std::log(static_cast<double>(keys[i].count));
+    n++;
+    sum_x += x;
+    sum_y += y;
+    sum_xx += x * x;
+    sum_xy += x * y;
+  }
+  double denom = n * sum_xx - sum_x * sum_x;
+  if (n < 2 || denom == 0) {
+    return 0;
+  }
+  return -(n * sum_xy - sum_x * sum_y) / denom;
+}
+
+} // ycsbc
@@ -0,0 +1,75 @@
+//
+//  hot_key_tracker.h
+//  YCSB-cpp
+//
+//  Copyright (c) 2020 Youngjae Lee <ls4154.lee@gmail.com>.
+//
+
+#ifndef YCSB_C_HOT_KEY_TRACKER_H_
+#define YCSB_C_HOT_KEY_TRACKER_H_
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "count_min_sketch.h"
+
+namespace ycsbc {
+
+///
+/// Heavy-hitter tracker over key numbers. Every thread counts its accesses in
+/// its own count-min sketch and keeps the k keys with the highest estimates;
+/// the per-thread state is merged when the result is asked for.
+///
+class HotKeyTracker {
+ public:
+  struct HotKey {
+    uint64_t key_num;
+    uint64_t count;
+  };
+
+  HotKeyTracker(size_t top_k, size_t sketch_width);
+
+  ///
+  /// Counts an access to key_num. Lock-free except for the first call of a thread.
+  ///
+  void Access(uint64_t key_num);
+
+  ///
+  /// Merges the per-thread state. Must not run concurrently with Access.
+  /// Returns the hottest keys in decreasing order of estimated count.
+  ///
+  std::vector<HotKey> TopKeys(uint64_t *total) const;
+
+  ///
+  /// Least-squares estimate of s in count ~ rank^(-s) over the given keys.
+  ///
+  static double EstimateSkew(const std::vector<HotKey> &keys);
+
+ private:
+  using Sketch = CountMinSketch<uint32_t>;
+
+  struct Shard {
+    explicit Shard(size_t width) : sketch(width), total(0) { }
+    Sketch sketch;
+    uint64_t total;
+    std::unordered_map<uint64_t, uint64_t> top; // key_num -> estimate
+    std::set<std::pair<uint64_t, uint64_t>> by_count; // (estimate, key_num)
+  };
+
+  Shard *LocalShard();
+
+  const size_t top_k_;
+  const size_t sketch_width_;
+  const uint64_t id_;
+
+  mutable std::mutex mutex_;
+  std::vector<std::unique_ptr<Shard>> shards_;
+};
+
+} // ycsbc
+
+#endif // YCSB_C_HOT_KEY_TRACKER_H_
@@ -0,0 +1,56 @@
+//
+//  hotspot_generator.h
+//  YCSB-cpp
+//
+//  Copyright (c) 2020 Youngjae Lee <ls4154.lee@gmail.com>.
+//
+
+#ifndef YCSB_C_HOTSPOT_GENERATOR_H_
+#define YCSB_C_HOTSPOT_GENERATOR_H_
+
+#include "generator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include "utils.h"
+
+namespace ycsbc {
+
+///
+/// Generates integers in [min, max] where a hot_set_fraction of the range,
+/// starting at min, receives a hot_opn_fraction of the operations.
+/// Values are uniform within the hot and the cold set.
+///
+class HotspotGenerator : public Generator<uint64_t> {
+ public:
+  HotspotGenerator(uint64_t min, uint64_t max, double hot_set_fraction, double hot_opn_fraction) :
+      min_(min), hot_opn_fraction_(std::min(1.0, std::max(0.0, hot_opn_fraction))) {
+    uint64_t items = max - min + 1;
+    hot_set_fraction = std::min(1.0, std::max(0.0, hot_set_fraction));
+    hot_items_ = static_cast<uint64_t>(items * hot_set_fraction);
+    cold_items_ = items - hot_items_;
+    Next();
+  }
+
+  uint64_t Next();
+  uint64_t Last() { return last_; }
+
+ private:
+  const uint64_t min_;
+  const double hot_opn_fraction_;
+  uint64_t hot_items_;
+  uint64_t cold_items_;
+  std::atomic<uint64_t> last_;
+};
+
+inline uint64_t HotspotGenerator::Next() {
+  bool hot = cold_items_ == 0 ||
+             (hot_items_ > 0 && utils::ThreadLocalRandomDouble() < hot_opn_fraction_);
+  uint64_t offset = utils::ThreadLocalRandomDouble() * (hot ? hot_items_ : cold_items_);
+  return last_ = min_ + (hot ? offset : hot_items_ + offset);
+}
+
+} // ycsbc
+
+#endif // YCSB_C_HOTSPOT_GENERATOR_H_
@@ -0,0 +1,184 @@
+//
+//  large_object_workload.cc
+//  YCSB-cpp
+//
+//  Copyright (c) 2020 Youngjae Lee <ls4154.lee@gmail.com>.
+//
+
+#include "large_object_workload.h"
+
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include "uniform_generator.h"
+#include "scrambled_zipfian_generator.h"
+#include "random_byte_generator.h"
+#include "core_workload.h"
+#include "workload_factory.h"
+#include "utils.h"
+
+namespace ycsbc {
+
+namespace {
+
+const std::string kRequestDistributionDefault = "zipfian";
+const std::string kDataField = "data";
+const int kChunkDigits = 6;
+const uint64_t kMaxChunks = 1000000;
+
+} // anonymous
+
+const std::string LargeObjectWorkload::MIN_SIZE_PROPERTY = "largeobject.minsize";
+const std::string LargeObjectWorkload::MIN_SIZE_DEFAULT = "65536";
+
+const std::string LargeObjectWorkload::MAX_SIZE_PROPERTY = "largeobject.maxsize";
+const std::string LargeObjectWorkload::MAX_SIZE_DEFAULT = "4194304";
+
+const std::string LargeObjectWorkload::CHUNK_SIZE_PROPERTY = "largeobject.chunksize";
+const std::string LargeObjectWorkload::CHUNK_SIZE_DEFAULT = "0";
+
+const std::string LargeObjectWorkload::READ_PROPORTION_DEFAULT = "0.5";
+const std::string LargeObjectWorkload::UPDATE_PROPORTION_DEFAULT = "0.5";
+
+void LargeObjectWorkload::Init(const utils::Properties &p) {
+  table_name_ = p.GetProperty(CoreWorkload::TABLENAME_PROPERTY, CoreWorkload::TABLENAME_DEFAULT);
+
+  min_size_ = std::stoull(p.GetProperty(MIN_SIZE_PROPERTY, MIN_SIZE_DEFAULT));
+  max_size_ = std::stoull(p.GetProperty(MAX_SIZE_PROPERTY, MAX_SIZE_DEFAULT));
+  chunk_size_ = std::stoull(p.GetProperty(CHUNK_SIZE_PROPERTY, CHUNK_SIZE_DEFAULT));
+  if (min_size_ == 0 || min_size_ > max_size_) {
+    throw utils::Exception("largeobject.minsize must be positive and at most largeobject.maxsize");
+  }
+  if (chunk_size_ > 0 && (max_size_ + chunk_size_ - 1) / chunk_size_ > kMaxChunks) {
+    throw utils::Exception("largeobject.chunksize leaves too many chunks per object");
+  }
+
+  object_count_ = std::stoull(p.GetProperty(CoreWorkload::RECORD_COUNT_PROPERTY));
+  if (object_count_ == 0) {
+    throw utils::Exception("recordcount must be positive");
+  }
+  object_digits_ = std::to_string(object_count_ - 1).size();
+
+  double read_proportion = std::stod(p.GetProperty(CoreWorkload::READ_PROPORTION_PROPERTY,
+                                                   READ_PROPORTION_DEFAULT));
+  double update_proportion = std::stod(p.GetProperty(CoreWorkload::UPDATE_PROPORTION_PROPERTY,
+                                                     UPDATE_PROPORTION_DEFAULT));
+  if (read_proportion > 0) {
+    op_chooser_.AddValue(READ, read_proportion);
+  }
+  if (update_proportion > 0) {
+    op_chooser_.AddValue(UPDATE, update_proportion);
+  }
+
+  std::string request_dist = p.GetProperty(CoreWorkload::REQUEST_DISTRIBUTION_PROPERTY,
+                                           kRequestDistributionDefault);
+  if (request_dist == "uniform") {
+    key_chooser_ = new UniformGenerator(0, object_count_ - 1);
+  } else if (request_dist == "zipfian") {
+    key_chooser_ = new ScrambledZipfianGenerator(object_count_, ZipfianGenerator::kZipfianConst);
+  } else {
+    throw utils::Exception("Unknown request distribution: " + request_dist);
+  }
+
+  insert_key_sequence_ = new CounterGenerator(std::stoull(
+      p.GetProperty(CoreWorkload::INSERT_START_PROPERTY, CoreWorkload::INSERT_START_DEFAULT)));
+
+  uint64_t max_value = chunk_size_ > 0 ? std::min(chunk_size_, max_size_) : max_size_;
+  random_data_.reserve(2 * max_value);
+  RandomByteGenerator byte_generator;
+  std::generate_n(std::back_inserter(random_data_), 2 * max_value,
+                  [&]() { return byte_generator.Next(); } );
+}
+
+std::string LargeObjectWorkload::ObjectKey(uint64_t object) const {
+  std::string object_num = std::to_string(object);
+  std::string key("object");
+  key.append(object_digits_ - std::min<size_t>(object_digits_, object_num.size()), '0');
+  return key.append(object_num);
+}
+
+std::string LargeObjectWorkload::ChunkKey(const std::string &object_key, uint64_t chunk) const {
+  std::string chunk_num = std::to_string(chunk);
+  std::string key(object_key);
+  key.append(1, ':').append(kChunkDigits - chunk_num.size(), '0');
+  return key.append(chunk_num);
+}
+
+uint64_t LargeObjectWorkload::ObjectSize(uint64_t object) const {
+  return min_size_ + utils::Hash(object) % (max_size_ - min_size_ + 1);
+}
+
+void LargeObjectWorkload::BuildValue(size_t len, std::vector<DB::Field> &values) const {
+  size_t off = utils::ThreadLocalRandomInt() % (random_data_.size() - len + 1);
+  values.push_back(DB::Field{kDataField, random_data_.substr(off, len)});
+}
+
+DB::Status LargeObjectWorkload::WriteObject(DB &db, uint64_t object, bool insert) {
+  const std::string key = ObjectKey(object);
+  uint64_t size = ObjectSize(object);
+  if (chunk_size_ == 0) {
+    std::vector<DB::Field> values;
+    BuildValue(size, values);
+    return insert ? db.Insert(table_name_, key, values) : db.Update(table_name_, key, values);
+  }
+  DB::Status status = DB::kOK;
+  for (uint64_t chunk = 0; chunk * chunk_size_ < size; chunk++) {
+    std::vector<DB::Field> values;
+    BuildValue(std::min(chunk_size_, size - chunk * chunk_size_), values);
+    const std::string chunk_key = ChunkKey(key, chunk);
+    DB::Status s = insert ? db.Insert(table_name_, chunk_key, values)
+                          : db.Update(table_name_, chunk_key, values);
+    if (s != DB::kOK) {
+      status = s;
+    }
+  }
+  return status;
+}
+
+DB::Status LargeObjectWorkload::ReadObject(DB &db, uint64_t object) {
+  const std::string key = ObjectKey(object);
+  if (chunk_size_ == 0) {
+    std::vector<DB::Field> result;
+    return db.Read(table_name_, key, NULL, result);
+  }
+  uint64_t size = ObjectSize(object);
+  DB::Status status = DB::kOK;
+  for (uint64_t chunk = 0; chunk * chunk_size_ < size; chunk++) {
+    std::vector<DB::Field> result;
+    DB::Status s = db.Read(table_name_, ChunkKey(key, chunk), NULL, result);
+    if (s != DB::kOK) {
+      status = s;
+    }
+  }
+  return status;
+}
+
+bool LargeObjectWorkload::DoInsert(DB &db, ThreadState *state) {
+  return WriteObject(db, insert_key_sequence_->Next(), true) == DB::kOK;
+}
+
+bool LargeObjectWorkload::DoTransaction(DB &db, ThreadState *state) {
+  if (op_chooser_.Empty()) {
+    throw utils::Exception("All operation proportions are zero");
+  }
+  DB::Status status;
+  switch (op_chooser_.Next()) {
+    case READ:
+      status = ReadObject(db, key_chooser_->Next());
+      break;
+    case UPDATE:
+      status = WriteObject(db, key_chooser_->Next(), false);
+      break;
+    default:
+      throw utils::Exception("Operation request is not recognized!");
+  }
+  return (status == DB::kOK);
+}
+
+Workload *NewLargeObjectWorkload() {
+  return new LargeObjectWorkload;
+}
+
+const bool registered = WorkloadFactory::RegisterWorkload("largeobject", NewLargeObjectWorkload);
+
+} // ycsbc
@@ -0,0 +1,98 @@
+//
+//  large_object_workload.h
+//  YCSB-cpp
+//
+//  Copyright (c) 2020 Youngjae Lee <ls4154.lee@gmail.com>.
+//
+
+#ifndef YCSB_C_LARGE_OBJECT_WORKLOAD_H_
+#define YCSB_C_LARGE_OBJECT_WORKLOAD_H_
+
+#include <string>
+#include <vector>
+#include "db.h"
+#include "workload.h"
+#include "properties.h"
+#include "generator.h"
+#include "discrete_generator.h"
+#include "counter_generator.h"
+
+namespace ycsbc {
+
+///
+/// Large objects, such as media metadata records of 64 KB to a few MB, read
+/// and rewritten whole. The size of an object is fixed by its id, uniform
+/// over [largeobject.minsize, largeobject.maxsize]. With a chunk size, an
+/// object is split over keys (object, chunk number), each read or updated as
+/// a record of its own, so measurements count chunks while the run
+/// operations count objects.
+/// Uses the table, requestdistribution, readproportion and updateproportion
+/// properties of the core workload.
+///
+class LargeObjectWorkload : public Workload {
+ public:
+  ///
+  /// The names of the properties for the smallest and largest object sizes in bytes.
+  ///
+  static const std::string MIN_SIZE_PROPERTY;
+  static const std::string MIN_SIZE_DEFAULT;
+  static const std::string MAX_SIZE_PROPERTY;
+  static const std::string MAX_SIZE_DEFAULT;
+
+  ///
+  /// The name of the property for the size of the chunks objects are split
+  /// into, in bytes. Zero stores each object under a single key.
+  ///
+  static const std::string CHUNK_SIZE_PROPERTY;
+  static const std::string CHUNK_SIZE_DEFAULT;
+
+  static const std::string READ_PROPORTION_DEFAULT;
+  static const std::string UPDATE_PROPORTION_DEFAULT;
+
+  void Init(const utils::Properties &p) override;
+
+  bool DoInsert(DB &db, ThreadState *state) override;
+  bool DoTransaction(DB &db, ThreadState *state) override;
+
+  LargeObjectWorkload() :
+      object_count_(0), min_size_(0), max_size_(0), chunk_size_(0), key_chooser_(nullptr),
+      insert_key_sequence_(nullptr) {
+  }
+
+  ~LargeObjectWorkload() override {
+    delete key_chooser_;
+    delete insert_key_sequence_;
+  }
+
+ private:
+  enum LargeObjectOperation {
+    READ = 0,
+    UPDATE
+  };
+
+  std::string ObjectKey(uint64_t object) const;
+  std::string ChunkKey(const std::string &object_key, uint64_t chunk) const;
+  uint64_t ObjectSize(uint64_t object) const;
+  void BuildValue(size_t len, std::vector<DB::Field> &values) const;
+
+  ///
+  /// Writes every chunk of an object, inserting or updating it.
+  ///
+  DB::Status WriteObject(DB &db, uint64_t object, bool insert);
+  DB::Status ReadObject(DB &db, uint64_t object);
+
+  std::string table_name_;
+  uint64_t object_count_;
+  int object_digits_;
+  uint64_t min_size_;
+  uint64_t max_size_;
+  uint64_t chunk_size_;
+  std::string random_data_; // values are slices of it, so building them is cheap
+  DiscreteGenerator<LargeObjectOperation> op_chooser_;
+  Generator<uint64_t> *key_chooser_;
+  CounterGenerator *insert_key_sequence_;
+};
+
+} // ycsbc
+
+#endif // YCSB_C_LARGE_OBJECT_WORKLOAD_H_
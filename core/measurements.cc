@@ -58,7 +58,9 @@ std::string BasicMeasurements::GetStatusMsg() {
                    ? static_cast<double>(latency_sum_[op].load(std::memory_order_relaxed)) / cnt
                    : 0) / 1000.0
                << "]";
-    total_cnt += cnt;
+    if (IsTotaledOperation(op)) {
+      total_cnt += cnt;
+    }
   }
   return std::to_string(total_cnt) + msg_stream.str();
 }
@@ -80,6 +82,10 @@ HdrHistogramMeasurements::HdrHistogramMeasurements() : count_{}, total_count_{}
 }
 
 void HdrHistogramMeasurements::Report(Operation op, uint64_t latency) {
+  if (!IsTotaledOperation(op)) {
+    count_[op].fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
   uint64_t cnt = total_count_.fetch_add(1, std::memory_order_relaxed);
   if (cnt >= 20000000) {
     hdr_record_value_atomic(histogram_[0], latency);
@@ -24,6 +24,7 @@ class Measurements {
   virtual void Report(Operation op, uint64_t latency) = 0;
   virtual std::string GetStatusMsg() = 0;
   virtual void Reset() = 0;
+  virtual ~Measurements() { }
 };
 
 class BasicMeasurements : public Measurements {
@@ -0,0 +1,137 @@
+//
+//  prefix_workload.cc
+//  YCSB-cpp
+//
+//  Copyright (c) 2020 Youngjae Lee <ls4154.lee@gmail.com>.
+//
+
+#include "prefix_workload.h"
+
+#include <algorithm>
+#include <string>
+#include "uniform_generator.h"
+#include "scrambled_zipfian_generator.h"
+#include "core_workload.h"
+#include "workload_factory.h"
+#include "utils.h"
+
+namespace ycsbc {
+
+namespace {
+
+const std::string kRequestDistributionDefault = "zipfian";
+const int kTenantDigits = 6;
+const int kUserDigits = 10;
+const int kItemDigits = 6;
+
+void AppendPadded(std::string &key, uint64_t num, int digits) {
+  std::string num_str = std::to_string(num);
+  key.append(digits - std::min<size_t>(digits, num_str.size()), '0').append(num_str);
+}
+
+} // anonymous
+
+const std::string PrefixWorkload::TENANT_COUNT_PROPERTY = "prefix.tenantcount";
+const std::string PrefixWorkload::TENANT_COUNT_DEFAULT = "10";
+
+const std::string PrefixWorkload::ITEMS_PER_USER_PROPERTY = "prefix.itemsperuser";
+const std::string PrefixWorkload::ITEMS_PER_USER_DEFAULT = "20";
+
+const std::string PrefixWorkload::READ_PROPORTION_DEFAULT = "0.1";
+const std::string PrefixWorkload::UPDATE_PROPORTION_DEFAULT = "0.1";
+const std::string PrefixWorkload::SCAN_PROPORTION_DEFAULT = "0.8";
+
+void PrefixWorkload::Init(const utils::Properties &p) {
+  RecordWorkload::Init(p);
+
+  tenant_count_ = std::stoull(p.GetProperty(TENANT_COUNT_PROPERTY, TENANT_COUNT_DEFAULT));
+  items_per_user_ = std::stoull(p.GetProperty(ITEMS_PER_USER_PROPERTY, ITEMS_PER_USER_DEFAULT));
+  if (tenant_count_ == 0 || items_per_user_ == 0) {
+    throw utils::Exception("prefix.tenantcount and prefix.itemsperuser must be positive");
+  }
+  // only users with all their items loaded are operated on
+  uint64_t user_count = std::stoull(p.GetProperty(CoreWorkload::RECORD_COUNT_PROPERTY)) /
+                        items_per_user_;
+  if (user_count == 0) {
+    throw utils::Exception("recordcount must be at least prefix.itemsperuser");
+  }
+
+  AddOperation(p, CoreWorkload::READ_PROPORTION_PROPERTY, READ_PROPORTION_DEFAULT,
+               [this](DB &db) { return TransactionRead(db); });
+  AddOperation(p, CoreWorkload::UPDATE_PROPORTION_PROPERTY, UPDATE_PROPORTION_DEFAULT,
+               [this](DB &db) { return TransactionUpdate(db); });
+  AddOperation(p, CoreWorkload::SCAN_PROPORTION_PROPERTY, SCAN_PROPORTION_DEFAULT,
+               [this](DB &db) { return TransactionScan(db); });
+
+  std::string request_dist = p.GetProperty(CoreWorkload::REQUEST_DISTRIBUTION_PROPERTY,
+                                           kRequestDistributionDefault);
+  if (request_dist == "uniform") {
+    user_chooser_ = new UniformGenerator(0, user_count - 1);
+  } else if (request_dist == "zipfian") {
+    user_chooser_ = new ScrambledZipfianGenerator(user_count, ZipfianGenerator::kZipfianConst);
+  } else {
+    throw utils::Exception("Unknown request distribution: " + request_dist);
+  }
+
+  insert_key_sequence_ = new CounterGenerator(std::stoull(
+      p.GetProperty(CoreWorkload::INSERT_START_PROPERTY, CoreWorkload::INSERT_START_DEFAULT)));
+}
+
+std::string PrefixWorkload::UserPrefix(uint64_t user) const {
+  std::string key("t");
+  AppendPadded(key, user % tenant_count_, kTenantDigits);
+  key.append("/u");
+  AppendPadded(key, user / tenant_count_, kUserDigits);
+  return key.append(1, '/');
+}
+
+std::string PrefixWorkload::ItemKey(uint64_t user, uint64_t item) const {
+  std::string key = UserPrefix(user).append(1, 'i');
+  AppendPadded(key, item, kItemDigits);
+  return key;
+}
+
+bool PrefixWorkload::DoInsert(DB &db, ThreadState *state) {
+  uint64_t record = insert_key_sequence_->Next();
+  std::vector<DB::Field> values;
+  BuildValues(record, values);
+  return db.Insert(table_name_, ItemKey(record / items_per_user_, record % items_per_user_),
+                   values) == DB::kOK;
+}
+
+DB::Status PrefixWorkload::TransactionRead(DB &db) {
+  uint64_t item = utils::ThreadLocalRandomInt() % items_per_user_;
+  std::vector<DB::Field> result;
+  return db.Read(table_name_, ItemKey(user_chooser_->Next(), item), NULL, result);
+}
+
+DB::Status PrefixWorkload::TransactionUpdate(DB &db) {
+  uint64_t user = user_chooser_->Next();
+  uint64_t item = utils::ThreadLocalRandomInt() % items_per_user_;
+  std::vector<DB::Field> values;
+  BuildValues(user * items_per_user_ + item, values);
+  return db.Update(table_name_, ItemKey(user, item), values);
+}
+
+DB::Status PrefixWorkload::TransactionScan(DB &db) {
+  // the scan ends with the prefix of the user, before the key of the next user
+  uint64_t user = user_chooser_->Next();
+  const std::string start_key = UserPrefix(user);
+  std::string end_key = start_key;
+  end_key.back() = '/' + 1;
+  std::vector<std::vector<DB::Field>> result;
+  DB::Status s = db.ScanRange(table_name_, start_key, end_key,
+                              static_cast<int>(items_per_user_), false, NULL, result);
+  if (s == DB::kNotImplemented) {
+    throw utils::Exception("The DB does not support range-bounded scans");
+  }
+  return s;
+}
+
+Workload *NewPrefixWorkload() {
+  return new PrefixWorkload;
+}
+
+const bool registered = WorkloadFactory::RegisterWorkload("prefix", NewPrefixWorkload);
+
+} // ycsbc
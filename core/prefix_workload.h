@@ -0,0 +1,83 @@
+//
+//  prefix_workload.h
+//  YCSB-cpp
+//
+//  Copyright (c) 2020 Youngjae Lee <ls4154.lee@gmail.com>.
+//
+
+#ifndef YCSB_C_PREFIX_WORKLOAD_H_
+#define YCSB_C_PREFIX_WORKLOAD_H_
+
+#include <string>
+#include <vector>
+#include "db.h"
+#include "record_workload.h"
+#include "properties.h"
+#include "generator.h"
+#include "counter_generator.h"
+
+namespace ycsbc {
+
+///
+/// Hierarchical keys tenant/user/item, such as "t000003/u0000000042/i000007",
+/// with fixed-width components, so the prefix of a user is always 20 bytes
+/// (rocksdb.prefix_extractor=fixed:20). Scans list all items of a user with
+/// DB::ScanRange, bounded to the prefix of the user, and reads and updates
+/// touch one item. The load phase inserts recordcount items,
+/// prefix.itemsperuser per user, spreading users round-robin over the tenants.
+/// Users are chosen by requestdistribution, "zipfian" (the default) or "uniform".
+/// Uses the table, fieldcount, fieldlength, fieldnameprefix, readproportion,
+/// updateproportion and scanproportion properties of the core workload.
+///
+class PrefixWorkload : public RecordWorkload {
+ public:
+  ///
+  /// The name of the property for the number of tenants.
+  ///
+  static const std::string TENANT_COUNT_PROPERTY;
+  static const std::string TENANT_COUNT_DEFAULT;
+
+  ///
+  /// The name of the property for the number of items of every user.
+  ///
+  static const std::string ITEMS_PER_USER_PROPERTY;
+  static const std::string ITEMS_PER_USER_DEFAULT;
+
+  static const std::string READ_PROPORTION_DEFAULT;
+  static const std::string UPDATE_PROPORTION_DEFAULT;
+  static const std::string SCAN_PROPORTION_DEFAULT;
+
+  void Init(const utils::Properties &p) override;
+
+  bool DoInsert(DB &db, ThreadState *state) override;
+
+  PrefixWorkload() :
+      tenant_count_(0), items_per_user_(0),
+      user_chooser_(nullptr), insert_key_sequence_(nullptr) {
+  }
+
+  ~PrefixWorkload() override {
+    delete user_chooser_;
+    delete insert_key_sequence_;
+  }
+
+ private:
+  ///
+  /// Returns the prefix of a user, numbered over all tenants.
+  ///
+  std::string UserPrefix(uint64_t user) const;
+  std::string ItemKey(uint64_t user, uint64_t item) const;
+
+  DB::Status TransactionRead(DB &db);
+  DB::Status TransactionUpdate(DB &db);
+  DB::Status TransactionScan(DB &db);
+
+  uint64_t tenant_count_;
+  uint64_t items_per_user_;
+  Generator<uint64_t> *user_chooser_;
+  CounterGenerator *insert_key_sequence_;
+};
+
+} // ycsbc
+
+#endif // YCSB_C_PREFIX_WORKLOAD_H_
@@ -28,6 +28,11 @@ class Properties {
   void SetProperty(const std::string &key, const std::string &value);
   bool ContainsKey(const std::string &key) const;
   void Load(std::ifstream &input);
+  ///
+  /// Copies the properties of other whose names start with prefix,
+  /// with the prefix stripped, overriding existing values.
+  ///
+  void Merge(const Properties &other, const std::string &prefix = std::string());
  private:
   std::map<std::string, std::string> properties_;
 };
@@ -54,6 +59,16 @@ inline bool Properties::ContainsKey(const std::string &key) const {
   return properties_.find(key) != properties_.end();
 }
 
+inline void Properties::Merge(const Properties &other, const std::string &prefix) {
+  std::map<std::string, std::string>::const_iterator it = other.properties_.lower_bound(prefix);
+  for (; it != other.properties_.end(); ++it) {
+    if (it->first.compare(0, prefix.size(), prefix) != 0) {
+      break;
+    }
+    SetProperty(it->first.substr(prefix.size()), it->second);
+  }
+}
+
 inline void Properties::Load(std::ifstream &input) {
   if (!input.is_open()) {
     throw utils::Exception("File not open!");
@@ -0,0 +1,144 @@
+//
+//  queue_workload.cc
+//  YCSB-cpp
+//
+//  Copyright (c) 2020 Youngjae Lee <ls4154.lee@gmail.com>.
+//
+
+#include "queue_workload.h"
+
+#include <string>
+#include <thread>
+#include "uniform_generator.h"
+#include "scrambled_zipfian_generator.h"
+#include "core_workload.h"
+#include "workload_factory.h"
+#include "utils.h"
+
+namespace ycsbc {
+
+namespace {
+
+const int kSequenceDigits = 20;
+
+} // anonymous
+
+const std::string QueueWorkload::QUEUE_COUNT_PROPERTY = "queue.count";
+const std::string QueueWorkload::QUEUE_COUNT_DEFAULT = "64";
+
+const std::string QueueWorkload::QUEUE_DISTRIBUTION_PROPERTY = "queue.distribution";
+const std::string QueueWorkload::QUEUE_DISTRIBUTION_DEFAULT = "uniform";
+
+const std::string QueueWorkload::CONSUMER_LAG_PROPERTY = "queue.consumerlag";
+const std::string QueueWorkload::CONSUMER_LAG_DEFAULT = "0";
+
+const std::string QueueWorkload::CONSUMER_SEEK_PROPERTY = "queue.consumerseek";
+const std::string QueueWorkload::CONSUMER_SEEK_DEFAULT = "start";
+
+const std::string QueueWorkload::PRODUCE_PROPORTION_PROPERTY = "queue.produceproportion";
+const std::string QueueWorkload::PRODUCE_PROPORTION_DEFAULT = "0.5";
+
+const std::string QueueWorkload::CONSUME_PROPORTION_PROPERTY = "queue.consumeproportion";
+const std::string QueueWorkload::CONSUME_PROPORTION_DEFAULT = "0.5";
+
+void QueueWorkload::Init(const utils::Properties &p) {
+  RecordWorkload::Init(p);
+
+  queue_count_ = std::stoull(p.GetProperty(QUEUE_COUNT_PROPERTY, QUEUE_COUNT_DEFAULT));
+  if (queue_count_ == 0) {
+    throw utils::Exception("queue.count must be positive");
+  }
+  queue_digits_ = std::to_string(queue_count_ - 1).size();
+  consumer_lag_ = std::stoull(p.GetProperty(CONSUMER_LAG_PROPERTY, CONSUMER_LAG_DEFAULT));
+  std::string seek = p.GetProperty(CONSUMER_SEEK_PROPERTY, CONSUMER_SEEK_DEFAULT);
+  if (seek != "start" && seek != "head") {
+    throw utils::Exception("Unknown consumer seek: " + seek);
+  }
+  seek_head_ = seek == "head";
+
+  AddOperation(p, PRODUCE_PROPORTION_PROPERTY, PRODUCE_PROPORTION_DEFAULT,
+               [this](DB &db) { return Produce(db); });
+  AddOperation(p, CONSUME_PROPORTION_PROPERTY, CONSUME_PROPORTION_DEFAULT,
+               [this](DB &db) { return Consume(db); });
+
+  std::string queue_dist = p.GetProperty(QUEUE_DISTRIBUTION_PROPERTY, QUEUE_DISTRIBUTION_DEFAULT);
+  if (queue_dist == "uniform") {
+    queue_chooser_ = new UniformGenerator(0, queue_count_ - 1);
+  } else if (queue_dist == "zipfian") {
+    queue_chooser_ = new ScrambledZipfianGenerator(queue_count_, ZipfianGenerator::kZipfianConst);
+  } else {
+    throw utils::Exception("Unknown queue distribution: " + queue_dist);
+  }
+
+  // message n of the load phase goes to queue n % queue.count
+  uint64_t record_count = std::stoull(p.GetProperty(CoreWorkload::RECORD_COUNT_PROPERTY));
+  heads_ = std::vector<std::atomic<uint64_t>>(queue_count_);
+  tails_ = std::vector<std::atomic<uint64_t>>(queue_count_);
+  published_ = std::vector<std::atomic<uint64_t>>(queue_count_);
+  for (uint64_t queue = 0; queue < queue_count_; queue++) {
+    uint64_t depth = record_count / queue_count_ + (queue < record_count % queue_count_ ? 1 : 0);
+    heads_[queue] = 0;
+    tails_[queue] = depth;
+    published_[queue] = depth;
+  }
+  insert_message_sequence_ = new CounterGenerator(std::stoull(
+      p.GetProperty(CoreWorkload::INSERT_START_PROPERTY, CoreWorkload::INSERT_START_DEFAULT)));
+}
+
+std::string QueueWorkload::QueueKey(uint64_t queue, uint64_t seq) const {
+  std::string queue_num = std::to_string(queue);
+  std::string seq_num = std::to_string(seq);
+  std::string key("queue");
+  key.append(queue_digits_ - queue_num.size(), '0').append(queue_num).append(1, ':');
+  key.append(kSequenceDigits - seq_num.size(), '0').append(seq_num);
+  return key;
+}
+
+bool QueueWorkload::DoInsert(DB &db, ThreadState *state) {
+  uint64_t message = insert_message_sequence_->Next();
+  std::vector<DB::Field> values;
+  BuildValues(message, values);
+  return db.Insert(table_name_, QueueKey(message % queue_count_, message / queue_count_),
+                   values) == DB::kOK;
+}
+
+DB::Status QueueWorkload::Produce(DB &db) {
+  uint64_t queue = queue_chooser_->Next();
+  uint64_t seq = tails_[queue].fetch_add(1);
+  std::vector<DB::Field> values;
+  BuildValues(seq * queue_count_ + queue, values);
+  DB::Status s = db.Insert(table_name_, QueueKey(queue, seq), values);
+  // publish in sequence order, so consumers never claim an unwritten message
+  uint64_t expected = seq;
+  while (!published_[queue].compare_exchange_weak(expected, seq + 1)) {
+    expected = seq;
+    std::this_thread::yield();
+  }
+  return s;
+}
+
+DB::Status QueueWorkload::Consume(DB &db) {
+  uint64_t queue = queue_chooser_->Next();
+  uint64_t head = heads_[queue].load();
+  do {
+    if (head + consumer_lag_ >= published_[queue].load()) {
+      return DB::kOK; // nothing to consume
+    }
+  } while (!heads_[queue].compare_exchange_weak(head, head + 1));
+
+  const std::string key = QueueKey(queue, head);
+  std::vector<std::vector<DB::Field>> result;
+  DB::Status s = db.Scan(table_name_, seek_head_ ? key : QueueKey(queue, 0), 1, NULL, result);
+  if (s != DB::kOK) {
+    return s;
+  }
+  return db.Delete(table_name_, key);
+}
+
+Workload *NewQueueWorkload() {
+  return new QueueWorkload;
+}
+
+const bool registered = WorkloadFactory::RegisterWorkload("queue", NewQueueWorkload);
+
+} // ycsbc
@@ -0,0 +1,103 @@
+//
+//  queue_workload.h
+//  YCSB-cpp
+//
+//  Copyright (c) 2020 Youngjae Lee <ls4154.lee@gmail.com>.
+//
+
+#ifndef YCSB_C_QUEUE_WORKLOAD_H_
+#define YCSB_C_QUEUE_WORKLOAD_H_
+
+#include <atomic>
+#include <string>
+#include <vector>
+#include "db.h"
+#include "record_workload.h"
+#include "properties.h"
+#include "generator.h"
+#include "counter_generator.h"
+
+namespace ycsbc {
+
+///
+/// Persistent queues stored as ordered keys (queue, sequence number).
+/// Producers append at the tail of a queue; consumers read the head of a queue
+/// with a one-record scan and delete it, leaving a growing run of tombstones
+/// in front of the live messages. The load phase spreads recordcount messages
+/// over the queues, so the initial depth is recordcount / queue.count.
+/// Uses the table, fieldcount, fieldlength and fieldnameprefix properties of
+/// the core workload.
+///
+class QueueWorkload : public RecordWorkload {
+ public:
+  ///
+  /// The name of the property for the number of queues.
+  ///
+  static const std::string QUEUE_COUNT_PROPERTY;
+  static const std::string QUEUE_COUNT_DEFAULT;
+
+  ///
+  /// The name of the property for the distribution of the queues produced to
+  /// and consumed from. Options are "uniform" and "zipfian".
+  ///
+  static const std::string QUEUE_DISTRIBUTION_PROPERTY;
+  static const std::string QUEUE_DISTRIBUTION_DEFAULT;
+
+  ///
+  /// The name of the property for the number of messages consumers leave in
+  /// a queue. A consumer finding no more messages than this consumes nothing.
+  ///
+  static const std::string CONSUMER_LAG_PROPERTY;
+  static const std::string CONSUMER_LAG_DEFAULT;
+
+  ///
+  /// The name of the property for where consumers start the scan for the head.
+  /// "start" scans from the beginning of the queue, over the tombstones of
+  /// the consumed messages, as a consumer not tracking its position does.
+  /// "head" scans from the key of the head message.
+  ///
+  static const std::string CONSUMER_SEEK_PROPERTY;
+  static const std::string CONSUMER_SEEK_DEFAULT;
+
+  ///
+  /// The names of the properties for the proportions of produce and consume operations.
+  ///
+  static const std::string PRODUCE_PROPORTION_PROPERTY;
+  static const std::string PRODUCE_PROPORTION_DEFAULT;
+  static const std::string CONSUME_PROPORTION_PROPERTY;
+  static const std::string CONSUME_PROPORTION_DEFAULT;
+
+  void Init(const utils::Properties &p) override;
+
+  bool DoInsert(DB &db, ThreadState *state) override;
+
+  QueueWorkload() :
+      queue_count_(0), consumer_lag_(0), seek_head_(false),
+      queue_chooser_(nullptr), insert_message_sequence_(nullptr) {
+  }
+
+  ~QueueWorkload() override {
+    delete queue_chooser_;
+    delete insert_message_sequence_;
+  }
+
+ private:
+  std::string QueueKey(uint64_t queue, uint64_t seq) const;
+
+  DB::Status Produce(DB &db);
+  DB::Status Consume(DB &db);
+
+  uint64_t queue_count_;
+  int queue_digits_;
+  uint64_t consumer_lag_;
+  bool seek_head_;
+  Generator<uint64_t> *queue_chooser_;
+  CounterGenerator *insert_message_sequence_;
+  std::vector<std::atomic<uint64_t>> heads_; // next message to consume, per queue
+  std::vector<std::atomic<uint64_t>> tails_; // next message to produce
+  std::vector<std::atomic<uint64_t>> published_; // messages before it are all written
+};
+
+} // ycsbc
+
+#endif // YCSB_C_QUEUE_WORKLOAD_H_
@@ -0,0 +1,58 @@
+//
+//  record_workload.cc
+//  YCSB-cpp
+//
+//  Copyright (c) 2020 Youngjae Lee <ls4154.lee@gmail.com>.
+//
+
+#include "record_workload.h"
+
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include "random_byte_generator.h"
+#include "core_workload.h"
+#include "utils.h"
+
+namespace ycsbc {
+
+void RecordWorkload::Init(const utils::Properties &p) {
+  table_name_ = p.GetProperty(CoreWorkload::TABLENAME_PROPERTY, CoreWorkload::TABLENAME_DEFAULT);
+  field_count_ = std::stoi(p.GetProperty(CoreWorkload::FIELD_COUNT_PROPERTY,
+                                         CoreWorkload::FIELD_COUNT_DEFAULT));
+  field_prefix_ = p.GetProperty(CoreWorkload::FIELD_NAME_PREFIX,
+                                CoreWorkload::FIELD_NAME_PREFIX_DEFAULT);
+  field_len_samples_ = CoreWorkload::GetFieldLenSamples(p);
+}
+
+void RecordWorkload::AddOperation(const utils::Properties &p, const std::string &property,
+                                  const std::string &default_proportion, TransactionOp op) {
+  double proportion = std::stod(p.GetProperty(property, default_proportion));
+  if (proportion > 0) {
+    op_chooser_.AddValue(ops_.size(), proportion);
+    ops_.push_back(op);
+  }
+}
+
+void RecordWorkload::BuildValues(uint64_t record, std::vector<DB::Field> &values) const {
+  for (int i = 0; i < field_count_; ++i) {
+    values.push_back(DB::Field());
+    DB::Field &field = values.back();
+    field.name.append(field_prefix_).append(std::to_string(i));
+    uint64_t hash = utils::Hash(utils::Hash(record) + i);
+    uint64_t len = field_len_samples_[hash % field_len_samples_.size()];
+    field.value.reserve(len);
+    RandomByteGenerator byte_generator;
+    std::generate_n(std::back_inserter(field.value), len,
+                    [&]() { return byte_generator.Next(); } );
+  }
+}
+
+bool RecordWorkload::DoTransaction(DB &db, ThreadState *state) {
+  if (ops_.empty()) {
+    throw utils::Exception("All operation proportions are zero");
+  }
+  return ops_[op_chooser_.Next()](db) == DB::kOK;
+}
+
+} // ycsbc
@@ -0,0 +1,67 @@
+//
+//  record_workload.h
+//  YCSB-cpp
+//
+//  Copyright (c) 2020 Youngjae Lee <ls4154.lee@gmail.com>.
+//
+
+#ifndef YCSB_C_RECORD_WORKLOAD_H_
+#define YCSB_C_RECORD_WORKLOAD_H_
+
+#include <functional>
+#include <string>
+#include <vector>
+#include "db.h"
+#include "workload.h"
+#include "properties.h"
+#include "discrete_generator.h"
+
+namespace ycsbc {
+
+///
+/// Base of workloads with records of random fields, shaped by the table,
+/// fieldcount, fieldlength, field_len_dist and fieldnameprefix properties of
+/// the core workload, and transactions chosen among operations by their
+/// proportions.
+///
+class RecordWorkload : public Workload {
+ public:
+  ///
+  /// Reads the record properties. Subclasses call it before their own Init.
+  ///
+  void Init(const utils::Properties &p) override;
+
+  bool DoTransaction(DB &db, ThreadState *state) override;
+
+  RecordWorkload() : field_count_(0) { }
+
+ protected:
+  typedef std::function<DB::Status(DB &)> TransactionOp;
+
+  ///
+  /// Adds an operation of the transaction phase, done in the proportion
+  /// given by a property. Operations with a zero proportion are left out.
+  ///
+  void AddOperation(const utils::Properties &p, const std::string &property,
+                    const std::string &default_proportion, TransactionOp op);
+
+  ///
+  /// Appends fieldcount fields of random bytes. Like in the core workload, the
+  /// field lengths are derived from the record number, so a record keeps them
+  /// across updates.
+  ///
+  void BuildValues(uint64_t record, std::vector<DB::Field> &values) const;
+
+  std::string table_name_;
+  int field_count_;
+  std::string field_prefix_;
+  std::vector<uint64_t> field_len_samples_;
+
+ private:
+  std::vector<TransactionOp> ops_;
+  DiscreteGenerator<size_t> op_chooser_;
+};
+
+} // ycsbc
+
+#endif // YCSB_C_RECORD_WORKLOAD_H_
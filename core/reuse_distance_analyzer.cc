@@ -0,0 +1,180 @@
+//
+//  reuse_distance_analyzer.cc
+//  YCSB-cpp
+//
+//  Copyright (c) 2020 Youngjae Lee <ls4154.lee@gmail.com>.
+//
+
+#include "reuse_distance_analyzer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+
+#include "utils.h"
+
+namespace ycsbc {
+
+namespace {
+
+const int kSubBuckets = 8;
+const uint64_t kInitialCapacity = 1 << 16;
+
+} // anonymous
+
+void ReuseDistanceAnalyzer::DistanceHistogram::Add(double distance, uint64_t count) {
+  int bucket = Bucket(distance);
+  if (bucket >= static_cast<int>(buckets_.size())) {
+    buckets_.resize(bucket + 1, 0);
+  }
+  buckets_[bucket] += count;
+}
+
+uint64_t ReuseDistanceAnalyzer::DistanceHistogram::CountUpTo(double size) const {
+  uint64_t count = 0;
+  for (size_t i = 0; i < buckets_.size() && BucketLimit(i) <= size; i++) {
+    count += buckets_[i];
+  }
+  return count;
+}
+
+double ReuseDistanceAnalyzer::DistanceHistogram::MaxDistance() const {
+  return buckets_.empty() ? 0 : BucketLimit(buckets_.size() - 1);
+}
+
+int ReuseDistanceAnalyzer::DistanceHistogram::Bucket(double distance) {
+  if (distance <= 1) {
+    return 0;
+  }
+  int exp;
+  double frac = std::frexp(distance, &exp); // distance = frac * 2^exp, frac in [0.5, 1)
+  int sub = std::min(kSubBuckets - 1, static_cast<int>((frac * 2 - 1) * kSubBuckets));
+  return (exp - 1) * kSubBuckets + sub;
+}
+
+double ReuseDistanceAnalyzer::DistanceHistogram::BucketLimit(int bucket) {
+  int exp = bucket / kSubBuckets;
+  int sub = bucket % kSubBuckets;
+  return std::ldexp(1.0 + static_cast<double>(sub + 1) / kSubBuckets, exp);
+}
+
+void ReuseDistanceAnalyzer::FenwickTree::Add(size_t pos, int64_t delta) {
+  for (pos++; pos < tree_.size(); pos += pos & -pos) {
+    tree_[pos] += delta;
+  }
+}
+
+int64_t ReuseDistanceAnalyzer::FenwickTree::Sum(size_t pos) const {
+  int64_t sum = 0;
+  for (pos++; pos > 0; pos -= pos & -pos) {
+    sum += tree_[pos];
+  }
+  return sum;
+}
+
+ReuseDistanceAnalyzer::ReuseDistanceAnalyzer(double sampling_rate, uint64_t default_record_size)
+    : threshold_(std::max<uint64_t>(1, std::min(1.0, sampling_rate) * kModulus)),
+      rate_(static_cast<double>(threshold_) / kModulus),
+      default_record_size_(default_record_size), accesses_(0), time_(0),
+      capacity_(kInitialCapacity), live_bytes_(0), samples_(0), cold_misses_(0) {
+  count_tree_.Reset(capacity_);
+  bytes_tree_.Reset(capacity_);
+}
+
+void ReuseDistanceAnalyzer::Access(uint64_t key_num, uint64_t record_size) {
+  accesses_.fetch_add(1, std::memory_order_relaxed);
+  if (utils::Hash(key_num) % kModulus >= threshold_) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (time_ == capacity_) {
+    Compact();
+  }
+  samples_++;
+
+  auto it = last_access_.find(key_num);
+  if (it == last_access_.end()) {
+    cold_misses_++;
+    if (record_size == 0) {
+      record_size = default_record_size_;
+    }
+    it = last_access_.emplace(key_num, Entry{time_, record_size}).first;
+  } else {
+    Entry &entry = it->second;
+    // distinct records touched since the previous access to this one
+    uint64_t records = last_access_.size() - count_tree_.Sum(entry.time);
+    uint64_t bytes = live_bytes_ - bytes_tree_.Sum(entry.time);
+    if (record_size == 0) {
+      record_size = entry.size;
+    }
+    record_histogram_.Add(records / rate_ + 1);
+    byte_histogram_.Add(bytes / rate_ + record_size);
+
+    count_tree_.Add(entry.time, -1);
+    bytes_tree_.Add(entry.time, -static_cast<int64_t>(entry.size));
+    live_bytes_ -= entry.size;
+    entry.time = time_;
+    entry.size = record_size;
+  }
+  count_tree_.Add(time_, 1);
+  bytes_tree_.Add(time_, record_size);
+  live_bytes_ += record_size;
+  time_++;
+}
+
+void ReuseDistanceAnalyzer::Compact() {
+  // renumber the last accesses densely, keeping their order
+  std::vector<Entry *> entries;
+  entries.reserve(last_access_.size());
+  for (auto &kv : last_access_) {
+    entries.push_back(&kv.second);
+  }
+  std::sort(entries.begin(), entries.end(),
+            [](const Entry *a, const Entry *b) { return a->time < b->time; });
+
+  if (entries.size() * 2 > capacity_) {
+    capacity_ *= 2;
+  }
+  count_tree_.Reset(capacity_);
+  bytes_tree_.Reset(capacity_);
+  for (time_ = 0; time_ < entries.size(); time_++) {
+    entries[time_]->time = time_;
+    count_tree_.Add(time_, 1);
+    bytes_tree_.Add(time_, entries[time_]->size);
+  }
+}
+
+void ReuseDistanceAnalyzer::PrintCurve(std::ostream &os, const std::string &prefix) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  double expected_samples = accesses_.load() * rate_;
+  os << prefix << "LRU hit ratio curve: sampling rate " << rate_ << ", sampled accesses "
+     << samples_ << " of " << accesses_.load() << ", sampled records " << last_access_.size()
+     << ", cold misses " << cold_misses_ << std::endl;
+  if (samples_ == 0) {
+    return;
+  }
+  PrintCurve(os, prefix, "records", record_histogram_, expected_samples, 1);
+  PrintCurve(os, prefix, "bytes", byte_histogram_, expected_samples,
+             std::max<uint64_t>(1, default_record_size_));
+}
+
+void ReuseDistanceAnalyzer::PrintCurve(std::ostream &os, const std::string &prefix,
+                                       const char *unit, const DistanceHistogram &histogram,
+                                       double expected_samples, double min_size) {
+  // SHARDS-adj: the difference between the expected and the actual number of
+  // samples is credited to the smallest distances
+  double adjustment = expected_samples - samples_;
+  double size = std::exp2(std::floor(std::log2(min_size)));
+  double max_size = histogram.MaxDistance() * 2;
+  std::streamsize precision = os.precision();
+  for (; size <= max_size; size *= 2) {
+    double hits = std::max(0.0, histogram.CountUpTo(size) + adjustment);
+    double ratio = std::min(1.0, hits / expected_samples);
+    os << prefix << "LRU hit ratio cache size(" << unit << "): " << std::fixed
+       << std::setprecision(0) << size << ' ' << std::setprecision(4) << ratio
+       << std::defaultfloat << std::setprecision(precision) << std::endl;
+  }
+}
+
+} // ycsbc
@@ -0,0 +1,101 @@
+//
+//  reuse_distance_analyzer.h
+//  YCSB-cpp
+//
+//  Copyright (c) 2020 Youngjae Lee <ls4154.lee@gmail.com>.
+//
+
+#ifndef YCSB_C_REUSE_DISTANCE_ANALYZER_H_
+#define YCSB_C_REUSE_DISTANCE_ANALYZER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ycsbc {
+
+///
+/// Online estimation of the LRU hit ratio curve of a key stream.
+/// Follows SHARDS: only keys whose hash falls under the sampling rate R are
+/// tracked, their LRU stack distances are measured exactly and scaled by 1/R.
+/// Distances are measured both in records and in bytes.
+///
+class ReuseDistanceAnalyzer {
+ public:
+  ReuseDistanceAnalyzer(double sampling_rate, uint64_t default_record_size);
+
+  ///
+  /// Records an access to key_num. record_size is the size of the record in
+  /// bytes if it is known (e.g., on writes), or zero to reuse the last known size.
+  ///
+  void Access(uint64_t key_num, uint64_t record_size = 0);
+
+  ///
+  /// Prints the estimated hit ratio for cache sizes growing by powers of two,
+  /// each line starting with prefix.
+  ///
+  void PrintCurve(std::ostream &os, const std::string &prefix);
+
+ private:
+  ///
+  /// Log-linear histogram of stack distances, 8 buckets per power of two.
+  ///
+  class DistanceHistogram {
+   public:
+    void Add(double distance, uint64_t count = 1);
+    ///
+    /// Number of accesses with a stack distance of at most size.
+    ///
+    uint64_t CountUpTo(double size) const;
+    double MaxDistance() const;
+   private:
+    static int Bucket(double distance);
+    static double BucketLimit(int bucket);
+    std::vector<uint64_t> buckets_;
+  };
+
+  class FenwickTree {
+   public:
+    void Reset(size_t size) { tree_.assign(size + 1, 0); }
+    void Add(size_t pos, int64_t delta);
+    int64_t Sum(size_t pos) const; // sum of [0, pos]
+   private:
+    std::vector<int64_t> tree_;
+  };
+
+  struct Entry {
+    uint64_t time;
+    uint64_t size;
+  };
+
+  void Compact();
+  void PrintCurve(std::ostream &os, const std::string &prefix, const char *unit,
+                  const DistanceHistogram &histogram, double expected_samples, double min_size);
+
+  const uint64_t threshold_; // sample if the key hash modulo kModulus is below it
+  const double rate_;
+  const uint64_t default_record_size_;
+  std::atomic<uint64_t> accesses_;
+
+  std::mutex mutex_;
+  std::unordered_map<uint64_t, Entry> last_access_;
+  FenwickTree count_tree_;
+  FenwickTree bytes_tree_;
+  uint64_t time_;
+  uint64_t capacity_;
+  uint64_t live_bytes_;
+  uint64_t samples_;
+  uint64_t cold_misses_;
+  DistanceHistogram record_histogram_;
+  DistanceHistogram byte_histogram_;
+
+  static const uint64_t kModulus = 1 << 24;
+};
+
+} // ycsbc
+
+#endif // YCSB_C_REUSE_DISTANCE_ANALYZER_H_
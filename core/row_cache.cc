@@ -0,0 +1,373 @@
+//
+//  row_cache.cc
+//  YCSB-cpp
+//
+//  Copyright (c) 2020 Youngjae Lee <ls4154.lee@gmail.com>.
+//
+
+#include "row_cache.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include "count_min_sketch.h"
+
+namespace ycsbc {
+
+namespace {
+
+using Row = RowCache::Row;
+
+// approximate bookkeeping overhead of one cached record
+const size_t kEntryOverhead = 64;
+
+size_t Charge(const std::string &key, const Row &row) {
+  size_t charge = kEntryOverhead + key.size();
+  for (const DB::Field &field : row) {
+    charge += field.name.size() + field.value.size();
+  }
+  return charge;
+}
+
+void MergeFields(Row &row, const Row &values) {
+  for (const DB::Field &new_field : values) {
+    bool found = false;
+    for (DB::Field &field : row) {
+      if (field.name == new_field.name) {
+        field.value = new_field.value;
+        found = true;
+        break;
+      }
+    }
+    if (!found) {
+      row.push_back(new_field);
+    }
+  }
+}
+
+struct Entry {
+  std::string key;
+  Row row;
+  size_t charge;
+  int segment;
+};
+
+using EntryList = std::list<Entry>;
+
+class LRUShard {
+ public:
+  LRUShard(size_t capacity, size_t) : capacity_(capacity), usage_(0) { }
+
+  bool Lookup(const std::string &key, Row *row) {
+    auto it = table_.find(key);
+    if (it == table_.end()) {
+      return false;
+    }
+    lru_.splice(lru_.begin(), lru_, it->second);
+    *row = it->second->row;
+    return true;
+  }
+
+  void Insert(const std::string &key, const Row &row) {
+    Erase(key);
+    size_t charge = Charge(key, row);
+    if (charge > capacity_) {
+      return;
+    }
+    lru_.push_front({key, row, charge, 0});
+    table_[key] = lru_.begin();
+    usage_ += charge;
+    Evict();
+  }
+
+  void Update(const std::string &key, const Row &values) {
+    auto it = table_.find(key);
+    if (it == table_.end()) {
+      return;
+    }
+    Entry &entry = *it->second;
+    MergeFields(entry.row, values);
+    usage_ -= entry.charge;
+    entry.charge = Charge(key, entry.row);
+    usage_ += entry.charge;
+    lru_.splice(lru_.begin(), lru_, it->second);
+    Evict();
+  }
+
+  void Erase(const std::string &key) {
+    auto it = table_.find(key);
+    if (it == table_.end()) {
+      return;
+    }
+    usage_ -= it->second->charge;
+    lru_.erase(it->second);
+    table_.erase(it);
+  }
+
+  void EraseRange(const std::string &start, const std::string &end) {
+    auto it = table_.lower_bound(start);
+    while (it != table_.end() && it->first < end) {
+      usage_ -= it->second->charge;
+      lru_.erase(it->second);
+      it = table_.erase(it);
+    }
+  }
+
+ private:
+  void Evict() {
+    while (usage_ > capacity_ && !lru_.empty()) {
+      Erase(lru_.back().key);
+    }
+  }
+
+  const size_t capacity_;
+  size_t usage_;
+  EntryList lru_;
+  std::map<std::string, EntryList::iterator> table_; // ordered for EraseRange
+};
+
+///
+/// Count-min sketch of 4-bit-saturating counters with periodic aging,
+/// as used by TinyLFU to estimate access frequency.
+///
+class FrequencySketch {
+ public:
+  FrequencySketch(size_t num_counters) : sketch_(num_counters), additions_(0) {
+    sample_size_ = 10 * sketch_.width();
+  }
+
+  void Increment(uint64_t hash) {
+    if (sketch_.Estimate(hash) < kMaxCount) {
+      sketch_.Add(hash, 1, kMaxCount);
+      if (++additions_ >= sample_size_) {
+        Age();
+      }
+    }
+  }
+
+  int Estimate(uint64_t hash) const {
+    return static_cast<int>(sketch_.Estimate(hash));
+  }
+
+ private:
+  static const int kMaxCount = 15;
+
+  // halve all counters so that the sketch follows shifts in popularity
+  void Age() {
+    sketch_.Halve();
+    additions_ /= 2;
+  }
+
+  CountMinSketch<uint8_t> sketch_;
+  size_t sample_size_;
+  size_t additions_;
+};
+
+class TinyLFUShard {
+ public:
+  TinyLFUShard(size_t capacity, size_t row_size_hint)
+      : sketch_(std::max<size_t>(1024, capacity / std::max<size_t>(1, row_size_hint))) {
+    window_capacity_ = std::max<size_t>(1, capacity / 100);
+    main_capacity_ = capacity - window_capacity_;
+    protected_capacity_ = main_capacity_ / 5 * 4;
+    usage_[kWindow] = usage_[kProbation] = usage_[kProtected] = 0;
+  }
+
+  bool Lookup(const std::string &key, Row *row) {
+    sketch_.Increment(hasher_(key));
+    auto it = table_.find(key);
+    if (it == table_.end()) {
+      return false;
+    }
+    Touch(it->second);
+    *row = it->second->row;
+    return true;
+  }
+
+  void Insert(const std::string &key, const Row &row) {
+    Erase(key);
+    size_t charge = Charge(key, row);
+    if (charge > window_capacity_ + main_capacity_) {
+      return;
+    }
+    segments_[kWindow].push_front({key, row, charge, kWindow});
+    table_[key] = segments_[kWindow].begin();
+    usage_[kWindow] += charge;
+    EvictWindow();
+  }
+
+  void Update(const std::string &key, const Row &values) {
+    auto it = table_.find(key);
+    if (it == table_.end()) {
+      return;
+    }
+    Entry &entry = *it->second;
+    MergeFields(entry.row, values);
+    usage_[entry.segment] -= entry.charge;
+    entry.charge = Charge(key, entry.row);
+    usage_[entry.segment] += entry.charge;
+    Touch(it->second);
+    EvictWindow();
+    EvictMain();
+  }
+
+  void Erase(const std::string &key) {
+    auto it = table_.find(key);
+    if (it == table_.end()) {
+      return;
+    }
+    Entry &entry = *it->second;
+    usage_[entry.segment] -= entry.charge;
+    segments_[entry.segment].erase(it->second);
+    table_.erase(it);
+  }
+
+  void EraseRange(const std::string &start, const std::string &end) {
+    auto it = table_.lower_bound(start);
+    while (it != table_.end() && it->first < end) {
+      Entry &entry = *it->second;
+      usage_[entry.segment] -= entry.charge;
+      segments_[entry.segment].erase(it->second);
+      it = table_.erase(it);
+    }
+  }
+
+ private:
+  enum Segment {
+    kWindow = 0,
+    kProbation,
+    kProtected
+  };
+
+  void MoveTo(EntryList::iterator it, int segment) {
+    usage_[it->segment] -= it->charge;
+    usage_[segment] += it->charge;
+    segments_[segment].splice(segments_[segment].begin(), segments_[it->segment], it);
+    it->segment = segment;
+  }
+
+  void Touch(EntryList::iterator it) {
+    if (it->segment == kProbation) {
+      MoveTo(it, kProtected);
+      while (usage_[kProtected] > protected_capacity_) {
+        MoveTo(std::prev(segments_[kProtected].end()), kProbation);
+      }
+    } else {
+      MoveTo(it, it->segment);
+    }
+  }
+
+  EntryList::iterator MainVictim() {
+    if (!segments_[kProbation].empty()) {
+      return std::prev(segments_[kProbation].end());
+    }
+    return std::prev(segments_[kProtected].end());
+  }
+
+  // moves window victims to the main space if they win the frequency contest
+  void EvictWindow() {
+    while (usage_[kWindow] > window_capacity_) {
+      EntryList::iterator candidate = std::prev(segments_[kWindow].end());
+      size_t main_usage = usage_[kProbation] + usage_[kProtected];
+      if (main_usage + candidate->charge > main_capacity_ && main_usage > 0) {
+        int candidate_freq = sketch_.Estimate(hasher_(candidate->key));
+        int victim_freq = sketch_.Estimate(hasher_(MainVictim()->key));
+        if (candidate_freq <= victim_freq) {
+          Erase(std::string(candidate->key));
+          continue;
+        }
+      }
+      MoveTo(candidate, kProbation);
+      EvictMain();
+    }
+  }
+
+  void EvictMain() {
+    while (usage_[kProbation] + usage_[kProtected] > main_capacity_) {
+      Erase(std::string(MainVictim()->key));
+    }
+  }
+
+  FrequencySketch sketch_;
+  std::hash<std::string> hasher_;
+  size_t window_capacity_;
+  size_t main_capacity_;
+  size_t protected_capacity_;
+  size_t usage_[3];
+  EntryList segments_[3];
+  std::map<std::string, EntryList::iterator> table_; // ordered for EraseRange
+};
+
+template <typename Shard>
+class ShardedRowCache : public RowCache {
+ public:
+  ShardedRowCache(size_t capacity, int num_shards, size_t row_size_hint) {
+    num_shards = std::max(1, num_shards);
+    for (int i = 0; i < num_shards; i++) {
+      shards_.emplace_back(new LockedShard(capacity / num_shards, row_size_hint));
+    }
+  }
+
+  bool Lookup(const std::string &key, Row *row) {
+    LockedShard &shard = GetShard(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    return shard.shard.Lookup(key, row);
+  }
+
+  void Insert(const std::string &key, const Row &row) {
+    LockedShard &shard = GetShard(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.shard.Insert(key, row);
+  }
+
+  void Update(const std::string &key, const Row &values) {
+    LockedShard &shard = GetShard(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.shard.Update(key, values);
+  }
+
+  void Erase(const std::string &key) {
+    LockedShard &shard = GetShard(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.shard.Erase(key);
+  }
+
+  void EraseRange(const std::string &start, const std::string &end) {
+    for (auto &shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard->mutex);
+      shard->shard.EraseRange(start, end);
+    }
+  }
+
+ private:
+  struct LockedShard {
+    LockedShard(size_t capacity, size_t row_size_hint) : shard(capacity, row_size_hint) { }
+    std::mutex mutex;
+    Shard shard;
+  };
+
+  LockedShard &GetShard(const std::string &key) {
+    // use the high bits, the low ones pick the sketch counters
+    uint64_t h = hasher_(key) * 0x9e3779b97f4a7c15ull;
+    return *shards_[(h >> 32) % shards_.size()];
+  }
+
+  std::hash<std::string> hasher_;
+  std::vector<std::unique_ptr<LockedShard>> shards_;
+};
+
+} // anonymous
+
+RowCache *NewLRURowCache(size_t capacity, int num_shards) {
+  return new ShardedRowCache<LRUShard>(capacity, num_shards, 0);
+}
+
+RowCache *NewTinyLFURowCache(size_t capacity, int num_shards, size_t row_size_hint) {
+  return new ShardedRowCache<TinyLFUShard>(capacity, num_shards, row_size_hint);
+}
+
+} // ycsbc
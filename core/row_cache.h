@@ -0,0 +1,65 @@
+//
+//  row_cache.h
+//  YCSB-cpp
+//
+//  Copyright (c) 2020 Youngjae Lee <ls4154.lee@gmail.com>.
+//
+
+#ifndef YCSB_C_ROW_CACHE_H_
+#define YCSB_C_ROW_CACHE_H_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "db.h"
+
+namespace ycsbc {
+
+///
+/// Concurrent in-process cache of whole records, bounded by the total
+/// number of bytes of keys, field names and values it holds.
+///
+class RowCache {
+ public:
+  using Row = std::vector<DB::Field>;
+
+  virtual ~RowCache() { }
+  ///
+  /// Copies the cached record into row and returns true on a hit.
+  ///
+  virtual bool Lookup(const std::string &key, Row *row) = 0;
+  ///
+  /// Caches the whole record, replacing any cached version.
+  ///
+  virtual void Insert(const std::string &key, const Row &row) = 0;
+  ///
+  /// Overwrites the given fields of the record if it is cached.
+  ///
+  virtual void Update(const std::string &key, const Row &values) = 0;
+  ///
+  /// Drops the record if it is cached.
+  ///
+  virtual void Erase(const std::string &key) = 0;
+  ///
+  /// Drops the cached records with keys in [start, end) from every shard.
+  ///
+  virtual void EraseRange(const std::string &start, const std::string &end) = 0;
+};
+
+///
+/// Sharded cache with per-shard LRU eviction.
+///
+RowCache *NewLRURowCache(size_t capacity, int num_shards);
+
+///
+/// Sharded cache with W-TinyLFU eviction: a small LRU admission window in
+/// front of a segmented LRU, admitting window victims only if a count-min
+/// sketch estimates them to be more frequently used than the main victim.
+/// row_size_hint sizes the frequency sketch.
+///
+RowCache *NewTinyLFURowCache(size_t capacity, int num_shards, size_t row_size_hint);
+
+} // ycsbc
+
+#endif // YCSB_C_ROW_CACHE_H_
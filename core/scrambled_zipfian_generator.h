@@ -15,24 +15,36 @@
 #include <unordered_map>
 #include <cstdint>
 #include <atomic>
+#include <vector>
+#include "feistel_permutation.h"
 #include "utils.h"
 #include "zipfian_generator.h"
 
 namespace ycsbc {
 
+///
+/// Zipfian distribution whose ranks are spread over the range by a bijective
+/// permutation, so every key keeps exactly the popularity of its rank.
+///
 class ScrambledZipfianGenerator : public Generator<uint64_t> {
  public:
   ScrambledZipfianGenerator(uint64_t min, uint64_t max, double zipfian_const) :
-      base_(min), num_items_(max - min + 1), generator_(0, 1000000000LL, zipfian_const) { }
+      base_(min), num_items_(max - min + 1), generator_(0, max - min, zipfian_const),
+      permutation_(num_items_) { }
 
   ScrambledZipfianGenerator(uint64_t num_items, double zipf_const) :
-      base_(0), num_items_(num_items),
-      generator_(0, 1000000000LL, zipf_const) { }
+      base_(0), num_items_(num_items), generator_(0, num_items - 1, zipf_const),
+      permutation_(num_items_) { }
 
   uint64_t Next();
 
   uint64_t Last();
 
+  ///
+  /// Returns the popularity rank of a generated value, 0 being the most popular.
+  ///
+  uint64_t Rank(uint64_t value) const { return permutation_.Invert(value - base_); }
+
   void SetOperationCount(uint64_t operation_count) {
     operation_count_ = operation_count;
     if (operation_count_ && !prepared_) {
@@ -42,14 +54,14 @@ class ScrambledZipfianGenerator : public Generator<uint64_t> {
   }
 
  private:
-  static constexpr double kZetan = 26.46902820178302;
   const uint64_t base_;
   const uint64_t num_items_;
   ZipfianGenerator generator_;
+  FeistelPermutation permutation_;
 
   bool                  prepared_ = false;
   uint64_t              operation_count_ = 0;
-  std::atomic<int>      index_{0};
+  std::atomic<uint64_t> index_{0};
   std::vector<uint64_t> samples_;
 
   void Prepare();
@@ -60,12 +72,12 @@ class ScrambledZipfianGenerator : public Generator<uint64_t> {
 };
 
 inline uint64_t ScrambledZipfianGenerator::Scramble(uint64_t value) const {
-  return base_ + utils::FNVHash64(value) % num_items_;
+  return base_ + permutation_.Permute(value);
 }
 
 inline uint64_t ScrambledZipfianGenerator::Next() {
   if (prepared_) {
-    return base_ + samples_[index_++];
+    return base_ + samples_[index_++ % samples_.size()];
   } else {
     return Scramble(generator_.Next());
   }
@@ -73,55 +85,23 @@ inline uint64_t ScrambledZipfianGenerator::Next() {
 
 inline uint64_t ScrambledZipfianGenerator::Last() {
   if (prepared_) {
-    return base_ + samples_[index_];
+    return base_ + samples_[index_ % samples_.size()];
   } else {
     return Scramble(generator_.Last());
   }
 }
 
-void ScrambledZipfianGenerator::Prepare() {
+inline void ScrambledZipfianGenerator::Prepare() {
   std::cout << "Prepare data" << std::endl;
   samples_.resize(operation_count_);
-  std::unordered_map<uint64_t, int> frequency;
   for (uint64_t i = 0; i < operation_count_; ++i) {
-    samples_[i] = utils::FNVHash64(generator_.Next());
-    frequency[samples_[i]]++;
-  }
-
-  std::unordered_map<uint64_t, uint64_t> mapper;
-  std::vector<std::pair<int, uint64_t>> frequency_sorted;
-  frequency_sorted.reserve(frequency.size());
-  for (auto& pair : frequency) {
-    frequency_sorted.emplace_back(pair.second, pair.first);
-  }
-  std::sort(frequency_sorted.begin(), frequency_sorted.end(),
-            [](const std::pair<int, uint64_t>& p1, const std::pair<int, uint64_t>& p2){
-              return p1.first > p2.first;
-            });
-
-  size_t idx = 0;
-  size_t runs = (frequency.size() + num_items_ - 1) / num_items_;
-  for (size_t run = 0; run < runs; ++run) {
-    std::mt19937_64 shuffle_rd;
-    srand((unsigned)time(0));
-    shuffle_rd.seed(rand());
-    std::vector<int> shuffled(num_items_);
-    std::iota(std::begin(shuffled), std::end(shuffled), 0);
-    std::shuffle(shuffled.begin(), shuffled.end(), shuffle_rd);
-
-    for (size_t i = 0; i < num_items_ && idx < frequency.size(); ++i) {
-      mapper[frequency_sorted[idx++].second] = shuffled[i];
-    }
-  }
-
-  for (auto& sample : samples_) {
-    sample = mapper[sample];
+    samples_[i] = permutation_.Permute(generator_.Next());
   }
 
   CheckFreq();
 }
 
-void ScrambledZipfianGenerator::CheckFreq() {
+inline void ScrambledZipfianGenerator::CheckFreq() {
   std::unordered_map<uint64_t, int> freqs;
   for (auto& value : samples_) {
     ++freqs[value];
@@ -0,0 +1,156 @@
+//
+//  session_workload.cc
+//  YCSB-cpp
+//
+//  Copyright (c) 2020 Youngjae Lee <ls4154.lee@gmail.com>.
+//
+
+#include "session_workload.h"
+
+#include <chrono>
+#include <string>
+#include "uniform_generator.h"
+#include "skewed_latest_generator.h"
+#include "core_workload.h"
+#include "workload_factory.h"
+#include "utils.h"
+
+namespace ycsbc {
+
+namespace {
+
+const std::string kRequestDistributionDefault = "latest";
+const std::string kExpiresField = "expires";
+
+// seconds since the epoch, so expiry times carry over from the load to later runs
+uint64_t NowSeconds() {
+  return std::chrono::duration_cast<std::chrono::seconds>(
+      std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+} // anonymous
+
+const std::string SessionWorkload::TTL_PROPERTY = "session.ttl";
+const std::string SessionWorkload::TTL_DEFAULT = "60";
+
+const std::string SessionWorkload::LAZY_DELETE_PROPERTY = "session.lazydelete";
+const std::string SessionWorkload::LAZY_DELETE_DEFAULT = "true";
+
+const std::string SessionWorkload::CREATE_PROPORTION_PROPERTY = "session.createproportion";
+const std::string SessionWorkload::CREATE_PROPORTION_DEFAULT = "0.05";
+
+const std::string SessionWorkload::READ_PROPORTION_PROPERTY = "session.readproportion";
+const std::string SessionWorkload::READ_PROPORTION_DEFAULT = "0.9";
+
+const std::string SessionWorkload::TOUCH_PROPORTION_PROPERTY = "session.touchproportion";
+const std::string SessionWorkload::TOUCH_PROPORTION_DEFAULT = "0.05";
+
+void SessionWorkload::Init(const utils::Properties &p) {
+  RecordWorkload::Init(p);
+
+  ttl_ = std::stoull(p.GetProperty(TTL_PROPERTY, TTL_DEFAULT));
+  lazy_delete_ = utils::StrToBool(p.GetProperty(LAZY_DELETE_PROPERTY, LAZY_DELETE_DEFAULT));
+
+  AddOperation(p, CREATE_PROPORTION_PROPERTY, CREATE_PROPORTION_DEFAULT,
+               [this](DB &db) { return Create(db); });
+  AddOperation(p, READ_PROPORTION_PROPERTY, READ_PROPORTION_DEFAULT,
+               [this](DB &db) { return Read(db); });
+  AddOperation(p, TOUCH_PROPORTION_PROPERTY, TOUCH_PROPORTION_DEFAULT,
+               [this](DB &db) { return Touch(db); });
+
+  uint64_t record_count = std::stoull(p.GetProperty(CoreWorkload::RECORD_COUNT_PROPERTY));
+  if (record_count == 0) {
+    throw utils::Exception("recordcount must be positive");
+  }
+  insert_key_sequence_ = new CounterGenerator(std::stoull(
+      p.GetProperty(CoreWorkload::INSERT_START_PROPERTY, CoreWorkload::INSERT_START_DEFAULT)));
+  transaction_insert_key_sequence_ = new AcknowledgedCounterGenerator(record_count);
+
+  std::string request_dist = p.GetProperty(CoreWorkload::REQUEST_DISTRIBUTION_PROPERTY,
+                                           kRequestDistributionDefault);
+  if (request_dist == "latest") {
+    key_chooser_ = new SkewedLatestGenerator(*transaction_insert_key_sequence_);
+  } else if (request_dist == "uniform") {
+    key_chooser_ = new UniformGenerator(0, record_count - 1);
+  } else {
+    throw utils::Exception("Unknown request distribution: " + request_dist);
+  }
+}
+
+std::string SessionWorkload::SessionKey(uint64_t session) const {
+  // session ids are spread over the key space like random tokens
+  return std::string("session").append(std::to_string(utils::Hash(session)));
+}
+
+void SessionWorkload::BuildSession(uint64_t session, std::vector<DB::Field> &values) const {
+  values.push_back(DB::Field{kExpiresField, utils::EncodeFixed64(NowSeconds() + ttl_)});
+  BuildValues(session, values);
+}
+
+bool SessionWorkload::DoInsert(DB &db, ThreadState *state) {
+  uint64_t session = insert_key_sequence_->Next();
+  std::vector<DB::Field> values;
+  BuildSession(session, values);
+  return db.Insert(table_name_, SessionKey(session), values) == DB::kOK;
+}
+
+void SessionWorkload::PrintReport(std::ostream &os, const std::string &prefix) {
+  os << prefix << "Expired sessions read: " << expired_reads_.load()
+     << ", lazily deleted: " << lazy_deletes_.load() << std::endl;
+}
+
+DB::Status SessionWorkload::ReadSession(DB &db, const std::string &key) {
+  std::vector<DB::Field> result;
+  DB::Status s = db.Read(table_name_, key, NULL, result);
+  if (s != DB::kOK) {
+    return s;
+  }
+  uint64_t expires = 0;
+  for (const DB::Field &field : result) {
+    if (field.name == kExpiresField) {
+      expires = utils::DecodeFixed64(field.value);
+      break;
+    }
+  }
+  if (expires > NowSeconds()) {
+    return DB::kOK;
+  }
+  expired_reads_.fetch_add(1, std::memory_order_relaxed);
+  if (lazy_delete_ && db.Delete(table_name_, key) == DB::kOK) {
+    lazy_deletes_.fetch_add(1, std::memory_order_relaxed);
+  }
+  return DB::kNotFound;
+}
+
+DB::Status SessionWorkload::Create(DB &db) {
+  uint64_t session = transaction_insert_key_sequence_->Next();
+  std::vector<DB::Field> values;
+  BuildSession(session, values);
+  DB::Status s = db.Insert(table_name_, SessionKey(session), values);
+  transaction_insert_key_sequence_->Acknowledge(session);
+  return s;
+}
+
+DB::Status SessionWorkload::Read(DB &db) {
+  return ReadSession(db, SessionKey(key_chooser_->Next()));
+}
+
+DB::Status SessionWorkload::Touch(DB &db) {
+  uint64_t session = key_chooser_->Next();
+  const std::string key = SessionKey(session);
+  DB::Status s = ReadSession(db, key);
+  if (s != DB::kOK) {
+    return s;
+  }
+  std::vector<DB::Field> values;
+  BuildSession(session, values);
+  return db.Update(table_name_, key, values);
+}
+
+Workload *NewSessionWorkload() {
+  return new SessionWorkload;
+}
+
+const bool registered = WorkloadFactory::RegisterWorkload("session", NewSessionWorkload);
+
+} // ycsbc
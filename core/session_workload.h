@@ -0,0 +1,106 @@
+//
+//  session_workload.h
+//  YCSB-cpp
+//
+//  Copyright (c) 2020 Youngjae Lee <ls4154.lee@gmail.com>.
+//
+
+#ifndef YCSB_C_SESSION_WORKLOAD_H_
+#define YCSB_C_SESSION_WORKLOAD_H_
+
+#include <atomic>
+#include <string>
+#include <vector>
+#include "db.h"
+#include "record_workload.h"
+#include "properties.h"
+#include "generator.h"
+#include "counter_generator.h"
+#include "acknowledged_counter_generator.h"
+
+namespace ycsbc {
+
+///
+/// Login sessions written with a time-to-live and never deleted explicitly.
+/// Each session record keeps its expiry time in the "expires" field. Reads
+/// favor recently created sessions; a read finding an expired session deletes
+/// it, the lazy deletion a client does on a store without expiry. Stores that
+/// expire records themselves, such as RocksDB with rocksdb.ttl, leave it to
+/// their compactions with session.lazydelete=false. Sessions are read and
+/// touched by requestdistribution, "latest" (the default) or "uniform".
+/// Uses the table, fieldcount, fieldlength and fieldnameprefix properties of
+/// the core workload.
+///
+class SessionWorkload : public RecordWorkload {
+ public:
+  ///
+  /// The name of the property for the time-to-live of a session in seconds.
+  ///
+  static const std::string TTL_PROPERTY;
+  static const std::string TTL_DEFAULT;
+
+  ///
+  /// The name of the property for whether reads delete the expired sessions
+  /// they find.
+  ///
+  static const std::string LAZY_DELETE_PROPERTY;
+  static const std::string LAZY_DELETE_DEFAULT;
+
+  ///
+  /// The names of the properties for the proportions of session creations,
+  /// reads, and touches, which read a session and extend its expiry.
+  ///
+  static const std::string CREATE_PROPORTION_PROPERTY;
+  static const std::string CREATE_PROPORTION_DEFAULT;
+  static const std::string READ_PROPORTION_PROPERTY;
+  static const std::string READ_PROPORTION_DEFAULT;
+  static const std::string TOUCH_PROPORTION_PROPERTY;
+  static const std::string TOUCH_PROPORTION_DEFAULT;
+
+  void Init(const utils::Properties &p) override;
+
+  bool DoInsert(DB &db, ThreadState *state) override;
+
+  void PrintReport(std::ostream &os, const std::string &prefix) override;
+
+  SessionWorkload() :
+      ttl_(0), lazy_delete_(true), key_chooser_(nullptr),
+      insert_key_sequence_(nullptr), transaction_insert_key_sequence_(nullptr),
+      expired_reads_(0), lazy_deletes_(0) {
+  }
+
+  ~SessionWorkload() override {
+    delete key_chooser_;
+    delete insert_key_sequence_;
+    delete transaction_insert_key_sequence_;
+  }
+
+ private:
+  std::string SessionKey(uint64_t session) const;
+
+  ///
+  /// Builds the fields of a session expiring ttl seconds from now.
+  ///
+  void BuildSession(uint64_t session, std::vector<DB::Field> &values) const;
+
+  ///
+  /// Reads a session, returning kNotFound if it is missing or has expired.
+  ///
+  DB::Status ReadSession(DB &db, const std::string &key);
+
+  DB::Status Create(DB &db);
+  DB::Status Read(DB &db);
+  DB::Status Touch(DB &db);
+
+  uint64_t ttl_;
+  bool lazy_delete_;
+  Generator<uint64_t> *key_chooser_;
+  CounterGenerator *insert_key_sequence_;
+  AcknowledgedCounterGenerator *transaction_insert_key_sequence_;
+  std::atomic<uint64_t> expired_reads_;
+  std::atomic<uint64_t> lazy_deletes_;
+};
+
+} // ycsbc
+
+#endif // YCSB_C_SESSION_WORKLOAD_H_
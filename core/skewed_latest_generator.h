@@ -11,31 +11,39 @@
 
 #include "generator.h"
 
+#include <algorithm>
 #include <atomic>
 #include <cstdint>
 #include "counter_generator.h"
+#include "growing_zipfian_generator.h"
 #include "zipfian_generator.h"
 
 namespace ycsbc {
 
+///
+/// Favors the most recently inserted keys. The zipfian ranks come from
+/// per-thread state that follows the counter, so threads do not serialize
+/// on the zeta updates caused by concurrent inserts.
+///
 class SkewedLatestGenerator : public Generator<uint64_t> {
  public:
   SkewedLatestGenerator(CounterGenerator &counter) :
-      basis_(counter), zipfian_(basis_.Last()) {
+      basis_(counter), ranks_(counter, 2, ZipfianGenerator::kZipfianConst) {
     Next();
   }
-  
+
   uint64_t Next();
   uint64_t Last() { return last_; }
  private:
   CounterGenerator &basis_;
-  ZipfianGenerator zipfian_;
+  GrowingZipfianGenerator ranks_;
   std::atomic<uint64_t> last_;
 };
 
 inline uint64_t SkewedLatestGenerator::Next() {
   uint64_t max = basis_.Last();
-  return last_ = max - zipfian_.Next(max);
+  uint64_t rank = ranks_.NextRank(std::max<uint64_t>(2, max));
+  return last_ = max > rank ? max - rank : 0;
 }
 
 } // ycsbc
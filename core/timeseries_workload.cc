@@ -0,0 +1,191 @@
+//
+//  timeseries_workload.cc
+//  YCSB-cpp
+//
+//  Copyright (c) 2020 Youngjae Lee <ls4154.lee@gmail.com>.
+//
+
+#include "timeseries_workload.h"
+
+#include <algorithm>
+#include <string>
+#include "uniform_generator.h"
+#include "zipfian_generator.h"
+#include "core_workload.h"
+#include "workload_factory.h"
+#include "utils.h"
+
+namespace ycsbc {
+
+namespace {
+
+const int kTimestampDigits = 20;
+
+} // anonymous
+
+const std::string TimeSeriesWorkload::SERIES_COUNT_PROPERTY = "timeseries.seriescount";
+const std::string TimeSeriesWorkload::SERIES_COUNT_DEFAULT = "100";
+
+const std::string TimeSeriesWorkload::SERIES_DISTRIBUTION_PROPERTY =
+    "timeseries.seriesdistribution";
+const std::string TimeSeriesWorkload::SERIES_DISTRIBUTION_DEFAULT = "uniform";
+
+const std::string TimeSeriesWorkload::SCAN_WINDOW_PROPERTY = "timeseries.scanwindow";
+const std::string TimeSeriesWorkload::SCAN_WINDOW_DEFAULT = "100";
+
+const std::string TimeSeriesWorkload::RETENTION_PROPERTY = "timeseries.retention";
+const std::string TimeSeriesWorkload::RETENTION_DEFAULT = "0";
+
+const std::string TimeSeriesWorkload::RETENTION_WINDOW_PROPERTY = "timeseries.retentionwindow";
+const std::string TimeSeriesWorkload::RETENTION_WINDOW_DEFAULT = "100";
+
+const std::string TimeSeriesWorkload::INSERT_PROPORTION_DEFAULT = "0.95";
+const std::string TimeSeriesWorkload::SCAN_PROPORTION_DEFAULT = "0.05";
+const std::string TimeSeriesWorkload::READ_PROPORTION_DEFAULT = "0";
+
+void TimeSeriesWorkload::Init(const utils::Properties &p) {
+  RecordWorkload::Init(p);
+
+  series_count_ = std::stoull(p.GetProperty(SERIES_COUNT_PROPERTY, SERIES_COUNT_DEFAULT));
+  if (series_count_ == 0) {
+    throw utils::Exception("timeseries.seriescount must be positive");
+  }
+  series_digits_ = std::to_string(series_count_ - 1).size();
+  scan_window_ = std::stoull(p.GetProperty(SCAN_WINDOW_PROPERTY, SCAN_WINDOW_DEFAULT));
+  retention_ = std::stoull(p.GetProperty(RETENTION_PROPERTY, RETENTION_DEFAULT));
+  retention_window_ = std::stoull(p.GetProperty(RETENTION_WINDOW_PROPERTY,
+                                                RETENTION_WINDOW_DEFAULT));
+  if (scan_window_ == 0 || retention_window_ == 0) {
+    throw utils::Exception("timeseries.scanwindow and timeseries.retentionwindow must be positive");
+  }
+
+  AddOperation(p, CoreWorkload::INSERT_PROPORTION_PROPERTY, INSERT_PROPORTION_DEFAULT,
+               [this](DB &db) { return TransactionInsert(db); });
+  AddOperation(p, CoreWorkload::SCAN_PROPORTION_PROPERTY, SCAN_PROPORTION_DEFAULT,
+               [this](DB &db) { return TransactionScan(db); });
+  AddOperation(p, CoreWorkload::READ_PROPORTION_PROPERTY, READ_PROPORTION_DEFAULT,
+               [this](DB &db) { return TransactionRead(db); });
+
+  std::string series_dist = p.GetProperty(SERIES_DISTRIBUTION_PROPERTY,
+                                          SERIES_DISTRIBUTION_DEFAULT);
+  if (series_dist == "uniform") {
+    series_chooser_ = new UniformGenerator(0, series_count_ - 1);
+  } else if (series_dist == "zipfian") {
+    series_chooser_ = new ZipfianGenerator(0, series_count_ - 1);
+  } else {
+    throw utils::Exception("Unknown series distribution: " + series_dist);
+  }
+
+  uint64_t record_count = std::stoull(p.GetProperty(CoreWorkload::RECORD_COUNT_PROPERTY));
+  uint64_t insert_start = std::stoull(p.GetProperty(CoreWorkload::INSERT_START_PROPERTY,
+                                                    CoreWorkload::INSERT_START_DEFAULT));
+  insert_point_sequence_ = new CounterGenerator(insert_start);
+  transaction_insert_point_sequence_ = new AcknowledgedCounterGenerator(record_count);
+}
+
+std::string TimeSeriesWorkload::BuildKeyName(uint64_t series, uint64_t timestamp) const {
+  std::string series_num = std::to_string(series);
+  std::string time_num = std::to_string(timestamp);
+  std::string key("series");
+  key.append(series_digits_ - series_num.size(), '0').append(series_num).append(1, ':');
+  key.append(kTimestampDigits - time_num.size(), '0').append(time_num);
+  return key;
+}
+
+bool TimeSeriesWorkload::LatestTimestamp(uint64_t series, uint64_t *timestamp) {
+  uint64_t point = transaction_insert_point_sequence_->Last();
+  if (point == UINT64_MAX) {
+    return false; // nothing loaded
+  }
+  uint64_t round = point / series_count_;
+  if (series > point % series_count_) {
+    if (round == 0) {
+      return false;
+    }
+    round--;
+  }
+  *timestamp = round;
+  return true;
+}
+
+uint64_t TimeSeriesWorkload::OldestTimestamp(uint64_t latest) const {
+  // the oldest point not yet deleted by ApplyRetention()
+  if (retention_ == 0 || latest < retention_ + retention_window_) {
+    return 0;
+  }
+  return (latest - retention_) / retention_window_ * retention_window_;
+}
+
+DB::Status TimeSeriesWorkload::Append(DB &db, uint64_t point) {
+  uint64_t series = point % series_count_;
+  uint64_t timestamp = point / series_count_;
+  std::vector<DB::Field> values;
+  BuildValues(point, values);
+  DB::Status s = db.Insert(table_name_, BuildKeyName(series, timestamp), values);
+  if (s == DB::kOK && retention_ > 0) {
+    s = ApplyRetention(db, series, timestamp);
+  }
+  return s;
+}
+
+DB::Status TimeSeriesWorkload::ApplyRetention(DB &db, uint64_t series, uint64_t timestamp) {
+  // every retention window, the window that fell out of the retention is deleted
+  if (timestamp < retention_ + retention_window_ ||
+      (timestamp - retention_) % retention_window_ != 0) {
+    return DB::kOK;
+  }
+  DB::Status status = DB::kOK;
+  uint64_t end = timestamp - retention_;
+  for (uint64_t t = end - retention_window_; t < end; t++) {
+    DB::Status s = db.Delete(table_name_, BuildKeyName(series, t));
+    if (s != DB::kOK && s != DB::kNotFound) {
+      status = s;
+    }
+  }
+  return status;
+}
+
+bool TimeSeriesWorkload::DoInsert(DB &db, ThreadState *state) {
+  return Append(db, insert_point_sequence_->Next()) == DB::kOK;
+}
+
+DB::Status TimeSeriesWorkload::TransactionInsert(DB &db) {
+  uint64_t point = transaction_insert_point_sequence_->Next();
+  DB::Status s = Append(db, point);
+  transaction_insert_point_sequence_->Acknowledge(point);
+  return s;
+}
+
+DB::Status TimeSeriesWorkload::TransactionScan(DB &db) {
+  uint64_t series = series_chooser_->Next();
+  uint64_t latest;
+  if (!LatestTimestamp(series, &latest)) {
+    return DB::kNotFound;
+  }
+  uint64_t start = latest + 1 - std::min(scan_window_, latest + 1);
+  start = std::max(start, OldestTimestamp(latest));
+  std::vector<std::vector<DB::Field>> result;
+  int len = static_cast<int>(latest - start + 1);
+  return db.Scan(table_name_, BuildKeyName(series, start), len, NULL, result);
+}
+
+DB::Status TimeSeriesWorkload::TransactionRead(DB &db) {
+  uint64_t series = series_chooser_->Next();
+  uint64_t latest;
+  if (!LatestTimestamp(series, &latest)) {
+    return DB::kNotFound;
+  }
+  uint64_t start = latest + 1 - std::min(scan_window_, latest + 1);
+  start = std::max(start, OldestTimestamp(latest));
+  uint64_t timestamp = start + utils::ThreadLocalRandomInt() % (latest - start + 1);
+  std::vector<DB::Field> result;
+  return db.Read(table_name_, BuildKeyName(series, timestamp), NULL, result);
+}
+
+Workload *NewTimeSeriesWorkload() {
+  return new TimeSeriesWorkload;
+}
+
+const bool registered = WorkloadFactory::RegisterWorkload("timeseries", NewTimeSeriesWorkload);
+
+} // ycsbc
@@ -0,0 +1,116 @@
+//
+//  timeseries_workload.h
+//  YCSB-cpp
+//
+//  Copyright (c) 2020 Youngjae Lee <ls4154.lee@gmail.com>.
+//
+
+#ifndef YCSB_C_TIMESERIES_WORKLOAD_H_
+#define YCSB_C_TIMESERIES_WORKLOAD_H_
+
+#include <string>
+#include <vector>
+#include "db.h"
+#include "record_workload.h"
+#include "properties.h"
+#include "generator.h"
+#include "counter_generator.h"
+#include "acknowledged_counter_generator.h"
+
+namespace ycsbc {
+
+///
+/// Appends points to a set of time series. Point n belongs to series
+/// n % seriescount at timestamp n / seriescount, so every series grows by one
+/// timestamp per round and the key (series, timestamp) sorts by series, then time.
+/// The transaction phase appends new points, scans the most recent window of a
+/// series and reads single recent points. With a retention, appending
+/// periodically deletes the oldest window of the series.
+/// Uses the table, fieldcount, fieldlength and fieldnameprefix properties and
+/// the insert, scan and read proportions of the core workload.
+///
+class TimeSeriesWorkload : public RecordWorkload {
+ public:
+  ///
+  /// The name of the property for the number of series.
+  ///
+  static const std::string SERIES_COUNT_PROPERTY;
+  static const std::string SERIES_COUNT_DEFAULT;
+
+  ///
+  /// The name of the property for the distribution of the series scanned and
+  /// read. Options are "uniform" and "zipfian" (favoring the first series).
+  ///
+  static const std::string SERIES_DISTRIBUTION_PROPERTY;
+  static const std::string SERIES_DISTRIBUTION_DEFAULT;
+
+  ///
+  /// The name of the property for the number of most recent points of a series
+  /// covered by scans and reads.
+  ///
+  static const std::string SCAN_WINDOW_PROPERTY;
+  static const std::string SCAN_WINDOW_DEFAULT;
+
+  ///
+  /// The name of the property for the number of points kept per series.
+  /// Zero keeps all points.
+  ///
+  static const std::string RETENTION_PROPERTY;
+  static const std::string RETENTION_DEFAULT;
+
+  ///
+  /// The name of the property for the number of points deleted at once per
+  /// series when the retention is exceeded.
+  ///
+  static const std::string RETENTION_WINDOW_PROPERTY;
+  static const std::string RETENTION_WINDOW_DEFAULT;
+
+  static const std::string INSERT_PROPORTION_DEFAULT;
+  static const std::string SCAN_PROPORTION_DEFAULT;
+  static const std::string READ_PROPORTION_DEFAULT;
+
+  void Init(const utils::Properties &p) override;
+
+  bool DoInsert(DB &db, ThreadState *state) override;
+
+  TimeSeriesWorkload() :
+      series_count_(0), scan_window_(0), retention_(0), retention_window_(0),
+      series_chooser_(nullptr), insert_point_sequence_(nullptr),
+      transaction_insert_point_sequence_(nullptr) {
+  }
+
+  ~TimeSeriesWorkload() override {
+    delete series_chooser_;
+    delete insert_point_sequence_;
+    delete transaction_insert_point_sequence_;
+  }
+
+ private:
+  std::string BuildKeyName(uint64_t series, uint64_t timestamp) const;
+
+  ///
+  /// Returns false if the series has no acknowledged point yet.
+  ///
+  bool LatestTimestamp(uint64_t series, uint64_t *timestamp);
+  uint64_t OldestTimestamp(uint64_t latest) const;
+
+  DB::Status Append(DB &db, uint64_t point);
+  DB::Status ApplyRetention(DB &db, uint64_t series, uint64_t timestamp);
+
+  DB::Status TransactionInsert(DB &db);
+  DB::Status TransactionScan(DB &db);
+  DB::Status TransactionRead(DB &db);
+
+  uint64_t series_count_;
+  int series_digits_;
+  uint64_t scan_window_;
+  uint64_t retention_;
+  uint64_t retention_window_;
+  Generator<uint64_t> *series_chooser_;
+  CounterGenerator *insert_point_sequence_;
+  AcknowledgedCounterGenerator *transaction_insert_point_sequence_;
+};
+
+} // ycsbc
+
+#endif // YCSB_C_TIMESERIES_WORKLOAD_H_
@@ -0,0 +1,168 @@
+//
+//  transaction_workload.cc
+//  YCSB-cpp
+//
+//  Copyright (c) 2020 Youngjae Lee <ls4154.lee@gmail.com>.
+//
+
+#include "transaction_workload.h"
+
+#include <algorithm>
+#include <string>
+#include "uniform_generator.h"
+#include "scrambled_zipfian_generator.h"
+#include "core_workload.h"
+#include "workload_factory.h"
+#include "measurements.h"
+#include "timer.h"
+#include "utils.h"
+
+namespace ycsbc {
+
+namespace {
+
+const std::string kRequestDistributionDefault = "zipfian";
+const std::string kStockField = "stock";
+
+} // anonymous
+
+const std::string TransactionWorkload::KEYS_PROPERTY = "transaction.keys";
+const std::string TransactionWorkload::KEYS_DEFAULT = "4";
+
+const std::string TransactionWorkload::MAX_RETRIES_PROPERTY = "transaction.maxretries";
+const std::string TransactionWorkload::MAX_RETRIES_DEFAULT = "10";
+
+const std::string TransactionWorkload::SORT_KEYS_PROPERTY = "transaction.sortkeys";
+const std::string TransactionWorkload::SORT_KEYS_DEFAULT = "true";
+
+const std::string TransactionWorkload::INITIAL_STOCK_PROPERTY = "transaction.initialstock";
+const std::string TransactionWorkload::INITIAL_STOCK_DEFAULT = "1000000";
+
+void TransactionWorkload::Init(const utils::Properties &p) {
+  table_name_ = p.GetProperty(CoreWorkload::TABLENAME_PROPERTY, CoreWorkload::TABLENAME_DEFAULT);
+
+  keys_ = std::stoul(p.GetProperty(KEYS_PROPERTY, KEYS_DEFAULT));
+  max_retries_ = std::stoi(p.GetProperty(MAX_RETRIES_PROPERTY, MAX_RETRIES_DEFAULT));
+  sort_keys_ = utils::StrToBool(p.GetProperty(SORT_KEYS_PROPERTY, SORT_KEYS_DEFAULT));
+  initial_stock_ = std::stoull(p.GetProperty(INITIAL_STOCK_PROPERTY, INITIAL_STOCK_DEFAULT));
+
+  item_count_ = std::stoull(p.GetProperty(CoreWorkload::RECORD_COUNT_PROPERTY));
+  if (keys_ == 0 || keys_ > item_count_) {
+    throw utils::Exception("transaction.keys must be positive and at most recordcount");
+  }
+  item_digits_ = std::to_string(item_count_ - 1).size();
+
+  std::string request_dist = p.GetProperty(CoreWorkload::REQUEST_DISTRIBUTION_PROPERTY,
+                                           kRequestDistributionDefault);
+  if (request_dist == "uniform") {
+    key_chooser_ = new UniformGenerator(0, item_count_ - 1);
+  } else if (request_dist == "zipfian") {
+    double zipfian_const = std::stod(p.GetProperty(CoreWorkload::ZIPFIAN_CONSTANT,
+                                                   CoreWorkload::ZIPFIAN_CONSTANT_DEFAULT));
+    key_chooser_ = new ScrambledZipfianGenerator(item_count_, zipfian_const);
+  } else {
+    throw utils::Exception("Unknown request distribution: " + request_dist);
+  }
+
+  insert_key_sequence_ = new CounterGenerator(std::stoull(
+      p.GetProperty(CoreWorkload::INSERT_START_PROPERTY, CoreWorkload::INSERT_START_DEFAULT)));
+}
+
+std::string TransactionWorkload::ItemKey(uint64_t item) const {
+  std::string item_num = std::to_string(item);
+  std::string key("item");
+  key.append(item_digits_ - std::min<size_t>(item_digits_, item_num.size()), '0');
+  return key.append(item_num);
+}
+
+bool TransactionWorkload::DoInsert(DB &db, ThreadState *state) {
+  std::vector<DB::Field> values;
+  values.push_back(DB::Field{kStockField, utils::EncodeFixed64(initial_stock_)});
+  return db.Insert(table_name_, ItemKey(insert_key_sequence_->Next()), values) == DB::kOK;
+}
+
+bool TransactionWorkload::DoTransaction(DB &db, ThreadState *state) {
+  return Order(db) == DB::kOK;
+}
+
+void TransactionWorkload::PrintReport(std::ostream &os, const std::string &prefix) {
+  uint64_t committed = committed_.load();
+  uint64_t aborted = aborted_attempts_.load();
+  uint64_t attempts = committed + aborted;
+  os << prefix << "Transactions committed: " << committed << ", aborted attempts: " << aborted
+     << " (abort rate " << (attempts ? 100.0 * aborted / attempts : 0) << "%), given up: "
+     << given_up_.load() << std::endl;
+}
+
+DB::Status TransactionWorkload::Attempt(DB &db, const std::vector<uint64_t> &items) {
+  DB::Status s = db.Begin();
+  if (s == DB::kNotImplemented) {
+    throw utils::Exception("The DB does not support transactions; for rocksdb, set "
+                           "rocksdb.transaction");
+  } else if (s != DB::kOK) {
+    return s;
+  }
+
+  std::vector<std::string> fields(1, kStockField);
+  std::vector<uint64_t> stock;
+  for (uint64_t item : items) {
+    std::vector<DB::Field> result;
+    s = db.Read(table_name_, ItemKey(item), &fields, result);
+    if (s != DB::kOK) {
+      db.Rollback();
+      return s;
+    }
+    stock.push_back(result.empty() ? 0 : utils::DecodeFixed64(result[0].value));
+  }
+  for (size_t i = 0; i < items.size(); i++) {
+    // sold out items are restocked, so the run never runs dry
+    uint64_t new_stock = stock[i] > 0 ? stock[i] - 1 : initial_stock_;
+    std::vector<DB::Field> values;
+    values.push_back(DB::Field{kStockField, utils::EncodeFixed64(new_stock)});
+    s = db.Update(table_name_, ItemKey(items[i]), values);
+    if (s != DB::kOK) {
+      db.Rollback();
+      return s;
+    }
+  }
+  return db.Commit();
+}
+
+DB::Status TransactionWorkload::Order(DB &db) {
+  std::vector<uint64_t> items;
+  while (items.size() < keys_) {
+    uint64_t item = key_chooser_->Next();
+    if (std::find(items.begin(), items.end(), item) == items.end()) {
+      items.push_back(item);
+    }
+  }
+  if (sort_keys_) {
+    std::sort(items.begin(), items.end());
+  }
+
+  utils::Timer<uint64_t, std::nano> timer;
+  timer.Start();
+  DB::Status s = Attempt(db, items);
+  for (int retry = 0; s == DB::kAborted && retry < max_retries_; retry++) {
+    aborted_attempts_.fetch_add(1, std::memory_order_relaxed);
+    s = Attempt(db, items);
+  }
+  if (s == DB::kOK) {
+    committed_.fetch_add(1, std::memory_order_relaxed);
+  } else if (s == DB::kAborted) {
+    aborted_attempts_.fetch_add(1, std::memory_order_relaxed);
+    given_up_.fetch_add(1, std::memory_order_relaxed);
+  }
+  if (measurements_) {
+    measurements_->Report(s == DB::kOK ? TRANSACTION : TRANSACTION_FAILED, timer.End());
+  }
+  return s;
+}
+
+Workload *NewTransactionWorkload() {
+  return new TransactionWorkload;
+}
+
+const bool registered = WorkloadFactory::RegisterWorkload("transaction", NewTransactionWorkload);
+
+} // ycsbc
@@ -0,0 +1,104 @@
+//
+//  transaction_workload.h
+//  YCSB-cpp
+//
+//  Copyright (c) 2020 Youngjae Lee <ls4154.lee@gmail.com>.
+//
+
+#ifndef YCSB_C_TRANSACTION_WORKLOAD_H_
+#define YCSB_C_TRANSACTION_WORKLOAD_H_
+
+#include <atomic>
+#include <string>
+#include <vector>
+#include "db.h"
+#include "workload.h"
+#include "properties.h"
+#include "generator.h"
+#include "counter_generator.h"
+
+namespace ycsbc {
+
+///
+/// Multi-key transactions on inventory items, such as taking an order for
+/// several products at once. Each transaction reads the stock of
+/// transaction.keys distinct items and writes it back decremented, all in one
+/// DB transaction, and is retried when it aborts on a conflict. Transactions
+/// are measured as TRANSACTION, including retries, and commits as COMMIT, and
+/// the report gives the abort rate. Contention is set by requestdistribution,
+/// "zipfian" (the default) or "uniform", and zipfianconstant.
+/// Uses the table property of the core workload.
+///
+class TransactionWorkload : public Workload {
+ public:
+  ///
+  /// The name of the property for the number of items in a transaction.
+  ///
+  static const std::string KEYS_PROPERTY;
+  static const std::string KEYS_DEFAULT;
+
+  ///
+  /// The name of the property for the number of times an aborted transaction
+  /// is retried before it is given up.
+  ///
+  static const std::string MAX_RETRIES_PROPERTY;
+  static const std::string MAX_RETRIES_DEFAULT;
+
+  ///
+  /// The name of the property for accessing the items of a transaction in key
+  /// order, so pessimistic transactions take their locks in the same order
+  /// and cannot deadlock.
+  ///
+  static const std::string SORT_KEYS_PROPERTY;
+  static const std::string SORT_KEYS_DEFAULT;
+
+  ///
+  /// The name of the property for the stock of an item when loaded or restocked.
+  ///
+  static const std::string INITIAL_STOCK_PROPERTY;
+  static const std::string INITIAL_STOCK_DEFAULT;
+
+  void Init(const utils::Properties &p) override;
+
+  bool DoInsert(DB &db, ThreadState *state) override;
+  bool DoTransaction(DB &db, ThreadState *state) override;
+
+  void PrintReport(std::ostream &os, const std::string &prefix) override;
+
+  TransactionWorkload() :
+      item_count_(0), keys_(0), max_retries_(0), sort_keys_(true), initial_stock_(0),
+      key_chooser_(nullptr), insert_key_sequence_(nullptr), committed_(0),
+      aborted_attempts_(0), given_up_(0) {
+  }
+
+  ~TransactionWorkload() override {
+    delete key_chooser_;
+    delete insert_key_sequence_;
+  }
+
+ private:
+  std::string ItemKey(uint64_t item) const;
+
+  ///
+  /// Runs one attempt of a transaction on the given items.
+  ///
+  DB::Status Attempt(DB &db, const std::vector<uint64_t> &items);
+  DB::Status Order(DB &db);
+
+  std::string table_name_;
+  uint64_t item_count_;
+  int item_digits_;
+  size_t keys_;
+  int max_retries_;
+  bool sort_keys_;
+  uint64_t initial_stock_;
+  Generator<uint64_t> *key_chooser_;
+  CounterGenerator *insert_key_sequence_;
+  std::atomic<uint64_t> committed_;
+  std::atomic<uint64_t> aborted_attempts_;
+  std::atomic<uint64_t> given_up_;
+};
+
+} // ycsbc
+
+#endif // YCSB_C_TRANSACTION_WORKLOAD_H_
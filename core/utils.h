@@ -13,6 +13,7 @@
 #include <cstdint>
 #include <exception>
 #include <random>
+#include <string>
 
 namespace ycsbc {
 
@@ -66,6 +67,31 @@ class Exception : public std::exception {
   std::string message_;
 };
 
+///
+/// Encodes value as 8 little-endian bytes, the format of counters.
+///
+inline std::string EncodeFixed64(uint64_t value) {
+  std::string buf(8, '\0');
+  for (int i = 0; i < 8; i++) {
+    buf[i] = static_cast<char>(value >> (8 * i));
+  }
+  return buf;
+}
+
+///
+/// Decodes a counter, taking anything but 8 bytes as zero.
+///
+inline uint64_t DecodeFixed64(const std::string &buf) {
+  if (buf.size() != 8) {
+    return 0;
+  }
+  uint64_t value = 0;
+  for (int i = 7; i >= 0; i--) {
+    value = (value << 8) | static_cast<unsigned char>(buf[i]);
+  }
+  return value;
+}
+
 inline bool StrToBool(std::string str) {
   std::transform(str.begin(), str.end(), str.begin(), ::tolower);
   if (str == "true" || str == "1") {
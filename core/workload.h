@@ -0,0 +1,80 @@
+//
+//  workload.h
+//  YCSB-cpp
+//
+//  Copyright (c) 2020 Youngjae Lee <ls4154.lee@gmail.com>.
+//
+
+#ifndef YCSB_C_WORKLOAD_H_
+#define YCSB_C_WORKLOAD_H_
+
+#include <ostream>
+#include <string>
+#include "db.h"
+#include "properties.h"
+
+namespace ycsbc {
+
+class Measurements;
+
+///
+/// Workload interface layer.
+/// One instance is shared by all client threads of a client group.
+///
+class Workload {
+ public:
+  ///
+  /// Per-thread workload state, owned by the client thread.
+  ///
+  class ThreadState {
+   public:
+    virtual ~ThreadState() { }
+  };
+
+  ///
+  /// Initializes the scenario.
+  /// Called once, in the main client thread, before any operations are started.
+  ///
+  virtual void Init(const utils::Properties &p) = 0;
+
+  ///
+  /// Creates the state of client thread thread_id of thread_count, or returns
+  /// nullptr if the workload keeps none. Called by each client thread at the
+  /// start of every phase; the thread deletes the state at the end of the phase.
+  ///
+  virtual ThreadState *InitThread(int thread_id, int thread_count) { return nullptr; }
+
+  ///
+  /// Does one insert of the load phase. Returns true if it succeeded.
+  ///
+  virtual bool DoInsert(DB &db, ThreadState *state) = 0;
+
+  ///
+  /// Does one operation of the transaction phase. Returns true if it succeeded.
+  ///
+  virtual bool DoTransaction(DB &db, ThreadState *state) = 0;
+
+  ///
+  /// Prints workload statistics gathered during the transaction phase.
+  ///
+  virtual void PrintReport(std::ostream &os, const std::string &prefix) { }
+
+  Workload() : measurements_(nullptr) { }
+
+  virtual ~Workload() { }
+
+  ///
+  /// Sets where the workload reports operations it times itself, such as
+  /// read-modify-writes made of several DB operations.
+  ///
+  void SetMeasurements(Measurements *measurements) {
+    measurements_ = measurements;
+  }
+
+ protected:
+  Measurements *measurements_;
+};
+
+} // ycsbc
+
+#endif // YCSB_C_WORKLOAD_H_
@@ -0,0 +1,33 @@
+//
+//  workload_factory.cc
+//  YCSB-cpp
+//
+//  Copyright (c) 2020 Youngjae Lee <ls4154.lee@gmail.com>.
+//
+
+#include "workload_factory.h"
+
+namespace ycsbc {
+
+std::map<std::string, WorkloadFactory::WorkloadCreator> &WorkloadFactory::Registry() {
+  static std::map<std::string, WorkloadCreator> registry;
+  return registry;
+}
+
+bool WorkloadFactory::RegisterWorkload(std::string workload_name,
+                                       WorkloadCreator workload_creator) {
+  Registry()[workload_name] = workload_creator;
+  return true;
+}
+
+Workload *WorkloadFactory::CreateWorkload(const utils::Properties &props) {
+  std::string workload_name = props.GetProperty("workload", "core");
+  std::map<std::string, WorkloadCreator> &registry = Registry();
+  auto it = registry.find(workload_name);
+  if (it == registry.end()) {
+    return nullptr;
+  }
+  return (*it->second)();
+}
+
+} // ycsbc
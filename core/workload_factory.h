@@ -0,0 +1,34 @@
+//
+//  workload_factory.h
+//  YCSB-cpp
+//
+//  Copyright (c) 2020 Youngjae Lee <ls4154.lee@gmail.com>.
+//
+
+#ifndef YCSB_C_WORKLOAD_FACTORY_H_
+#define YCSB_C_WORKLOAD_FACTORY_H_
+
+#include "workload.h"
+#include "properties.h"
+
+#include <string>
+#include <map>
+
+namespace ycsbc {
+
+class WorkloadFactory {
+ public:
+  using WorkloadCreator = Workload *(*)();
+  static bool RegisterWorkload(std::string workload_name, WorkloadCreator workload_creator);
+  ///
+  /// Creates the workload named by the "workload" property, or returns nullptr
+  /// if no workload of that name is registered. The workload is not initialized.
+  ///
+  static Workload *CreateWorkload(const utils::Properties &props);
+ private:
+  static std::map<std::string, WorkloadCreator> &Registry();
+};
+
+} // ycsbc
+
+#endif // YCSB_C_WORKLOAD_FACTORY_H_
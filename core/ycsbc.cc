@@ -11,6 +11,8 @@
 
 #include <string>
 #include <iostream>
+#include <map>
+#include <set>
 #include <vector>
 #include <thread>
 #include <future>
@@ -24,12 +26,36 @@
 #include "core_workload.h"
 #include "countdown_latch.h"
 #include "db_factory.h"
+#include "workload_factory.h"
 
 void UsageMessage(const char *command);
 bool StrStartWith(const char *str, const char *pre);
 void ParseCommandLine(int argc, const char *argv[], ycsbc::utils::Properties &props);
 
-void StatusThread(ycsbc::Measurements *measurements, CountDownLatch *latch, int interval) {
+///
+/// A set of client threads sharing one workload, one measurements instance and
+/// one target rate. Several groups may run concurrently against the same database.
+///
+struct ClientGroup {
+  std::string name;
+  ycsbc::utils::Properties props;
+  ycsbc::Measurements *measurements;
+  ycsbc::Workload *wl;
+  std::vector<ycsbc::DB *> dbs;
+  int num_threads;
+  double target;
+
+  std::string Prefix() const {
+    return name.empty() ? std::string() : "[" + name + "] ";
+  }
+};
+
+ClientGroup *CreateClientGroup(const std::string &name, const ycsbc::utils::Properties &props);
+std::vector<ClientGroup *> CreateClientGroups(const ycsbc::utils::Properties &props);
+std::vector<ClientGroup *> CreateLoadGroups(const std::vector<ClientGroup *> &groups,
+                                            const ycsbc::utils::Properties &props);
+
+void StatusThread(std::vector<ClientGroup *> *groups, CountDownLatch *latch, int interval) {
   using namespace std::chrono;
   time_point<system_clock> start = system_clock::now();
   bool done = false;
@@ -38,10 +64,12 @@ void StatusThread(ycsbc::Measurements *measurements, CountDownLatch *latch, int
     std::time_t now_c = system_clock::to_time_t(now);
     duration<double> elapsed_time = now - start;
 
-    std::cout << std::put_time(std::localtime(&now_c), "%F %T") << ' '
-              << static_cast<long long>(elapsed_time.count()) << " sec: ";
+    for (ClientGroup *group : *groups) {
+      std::cout << std::put_time(std::localtime(&now_c), "%F %T") << ' '
+                << static_cast<long long>(elapsed_time.count()) << " sec: ";
 
-    std::cout << measurements->GetStatusMsg() << std::endl;
+      std::cout << group->Prefix() << group->measurements->GetStatusMsg() << std::endl;
+    }
 
     if (done) {
       break;
@@ -50,6 +78,129 @@ void StatusThread(ycsbc::Measurements *measurements, CountDownLatch *latch, int
   };
 }
 
+int LongReaderThread(ycsbc::DB *db, CountDownLatch *stop, int hold_time) {
+  // an analytics reader keeping a snapshot open, replaced every hold_time
+  // seconds or, with zero, held until the phase ends
+  int snapshots = 0;
+  bool done = false;
+  while (!done) {
+    if (db->HoldSnapshot() != ycsbc::DB::kOK) {
+      throw ycsbc::utils::Exception("The DB does not support long-lived snapshots");
+    }
+    snapshots++;
+    if (hold_time > 0) {
+      done = stop->AwaitFor(hold_time);
+    } else {
+      stop->Await();
+      done = true;
+    }
+    db->ReleaseSnapshot();
+  }
+  return snapshots;
+}
+
+void PrintSpaceStats(const std::map<std::string, uint64_t> &before,
+                     const std::map<std::string, uint64_t> &after) {
+  for (const auto &entry : after) {
+    auto it = before.find(entry.first);
+    uint64_t start = it == before.end() ? 0 : it->second;
+    std::cout << "Space " << entry.first << ": " << start << " -> " << entry.second << " ("
+              << std::showpos << static_cast<long long>(entry.second - start) << std::noshowpos
+              << ")" << std::endl;
+  }
+}
+
+int GroupThread(ClientGroup *group, bool is_loading, bool init_db, bool cleanup_db,
+                CountDownLatch *latch, double *runtime) {
+  const std::string &count_prop = is_loading ? ycsbc::CoreWorkload::RECORD_COUNT_PROPERTY
+                                             : ycsbc::CoreWorkload::OPERATION_COUNT_PROPERTY;
+  const int total_ops = stoi(group->props[count_prop]);
+  const int num_threads = group->num_threads;
+  const double thread_target = group->target / num_threads;
+
+  ycsbc::utils::Timer<double> timer;
+  timer.Start();
+  std::vector<std::future<int>> client_threads;
+  for (int i = 0; i < num_threads; ++i) {
+    int thread_ops = total_ops / num_threads;
+    if (i < total_ops % num_threads) {
+      thread_ops++;
+    }
+    client_threads.emplace_back(std::async(std::launch::async, ycsbc::ClientThread,
+                                           group->dbs[i], group->wl, i, num_threads, thread_ops,
+                                           is_loading, init_db, cleanup_db, latch,
+                                           thread_target));
+  }
+  assert((int)client_threads.size() == num_threads);
+
+  int sum = 0;
+  for (auto &n : client_threads) {
+    assert(n.valid());
+    sum += n.get();
+  }
+  *runtime = timer.End();
+  return sum;
+}
+
+void RunPhase(std::vector<ClientGroup *> &groups, bool is_loading, bool init_db, bool cleanup_db,
+              bool show_status, int status_interval) {
+  int total_threads = 0;
+  for (ClientGroup *group : groups) {
+    total_threads += group->num_threads;
+  }
+
+  CountDownLatch latch(total_threads);
+  ycsbc::utils::Timer<double> timer;
+
+  timer.Start();
+  std::future<void> status_future;
+  if (show_status) {
+    status_future = std::async(std::launch::async, StatusThread,
+                               &groups, &latch, status_interval);
+  }
+  std::vector<double> group_runtimes(groups.size());
+  std::vector<std::future<int>> group_threads;
+  for (size_t i = 0; i < groups.size(); ++i) {
+    group_threads.emplace_back(std::async(std::launch::async, GroupThread, groups[i], is_loading,
+                                          init_db, cleanup_db, &latch, &group_runtimes[i]));
+  }
+
+  int sum = 0;
+  std::vector<int> group_sums;
+  for (auto &n : group_threads) {
+    assert(n.valid());
+    group_sums.push_back(n.get());
+    sum += group_sums.back();
+  }
+  double runtime = timer.End();
+
+  if (show_status) {
+    status_future.wait();
+  }
+
+  const char *phase = is_loading ? "Load" : "Run";
+  if (groups.size() > 1) {
+    for (size_t i = 0; i < groups.size(); ++i) {
+      const std::string prefix = groups[i]->Prefix();
+      std::cout << prefix << phase << " runtime(sec): " << group_runtimes[i] << std::endl;
+      std::cout << prefix << phase << " operations(ops): " << group_sums[i] << std::endl;
+      std::cout << prefix << phase << " throughput(ops/sec): "
+                << group_sums[i] / group_runtimes[i] << std::endl;
+      std::cout << prefix << phase << " latency(us): "
+                << groups[i]->measurements->GetStatusMsg() << std::endl;
+    }
+  }
+  std::cout << phase << " runtime(sec): " << runtime << std::endl;
+  std::cout << phase << " operations(ops): " << sum << std::endl;
+  std::cout << phase << " throughput(ops/sec): " << sum / runtime << std::endl;
+
+  if (!is_loading) {
+    for (ClientGroup *group : groups) {
+      group->wl->PrintReport(std::cout, group->Prefix());
+    }
+  }
+}
+
 int main(const int argc, const char *argv[]) {
   ycsbc::utils::Properties props;
   ParseCommandLine(argc, argv, props);
@@ -61,116 +212,205 @@ int main(const int argc, const char *argv[]) {
     exit(1);
   }
 
-  const int num_threads = stoi(props.GetProperty("threadcount", "1"));
-
-  ycsbc::Measurements *measurements = ycsbc::CreateMeasurements(&props);
-  if (measurements == nullptr) {
-    std::cerr << "Unknown measurements name" << std::endl;
-    exit(1);
-  }
-
-  std::vector<ycsbc::DB *> dbs;
-  for (int i = 0; i < num_threads; i++) {
-    ycsbc::DB *db = ycsbc::DBFactory::CreateDB(&props, measurements);
-    if (db == nullptr) {
-      std::cerr << "Unknown database name " << props["dbname"] << std::endl;
-      exit(1);
-    }
-    dbs.push_back(db);
-  }
-
-  ycsbc::CoreWorkload wl;
-  wl.Init(props);
+  std::vector<ClientGroup *> groups = CreateClientGroups(props);
 
   const bool show_status = (props.GetProperty("status", "false") == "true");
   const int status_interval = std::stoi(props.GetProperty("status.interval", "10"));
 
+  // with several client groups, the records are loaded by groups of their own, whose DBs
+  // stay open until the transaction phase is over
+  const bool separate_load = do_load && groups.size() > 1;
+  std::vector<ClientGroup *> load_groups;
+  if (separate_load) {
+    load_groups = CreateLoadGroups(groups, props);
+  } else if (do_load) {
+    load_groups = groups;
+  }
+
   // load phase
   if (do_load) {
-    const int total_ops = stoi(props[ycsbc::CoreWorkload::RECORD_COUNT_PROPERTY]);
+    RunPhase(load_groups, true, true, !do_transaction, show_status, status_interval);
+  }
 
-    CountDownLatch latch(num_threads);
-    ycsbc::utils::Timer<double> timer;
+  for (ClientGroup *group : groups) {
+    group->measurements->Reset();
+  }
+  std::this_thread::sleep_for(std::chrono::seconds(stoi(props.GetProperty("sleepafterload", "0"))));
 
-    timer.Start();
-    std::future<void> status_future;
-    if (show_status) {
-      status_future = std::async(std::launch::async, StatusThread,
-                                 measurements, &latch, status_interval);
+  // transaction phase
+  if (do_transaction) {
+    const bool long_reader = (props.GetProperty("longreader", "false") == "true");
+    const bool space_stats = (props.GetProperty("spacestats", "false") == "true");
+    const int hold_time = std::stoi(props.GetProperty("longreader.holdtime", "0"));
+
+    // a DB instance of its own, opened before the client threads and closed after them
+    ycsbc::DB *monitor_db = nullptr;
+    std::map<std::string, uint64_t> space_before;
+    if (long_reader || space_stats) {
+      monitor_db = ycsbc::DBFactory::CreateDB(&groups[0]->props, groups[0]->measurements);
+      monitor_db->Init();
     }
-    std::vector<std::future<int>> client_threads;
-    for (int i = 0; i < num_threads; ++i) {
-      int thread_ops = total_ops / num_threads;
-      if (i < total_ops % num_threads) {
-        thread_ops++;
+    // probe the DB now rather than fail in the reader thread or print nothing after the run
+    if (long_reader) {
+      if (monitor_db->HoldSnapshot() != ycsbc::DB::kOK) {
+        std::cerr << "The DB does not support long-lived snapshots" << std::endl;
+        exit(1);
       }
-      client_threads.emplace_back(std::async(std::launch::async, ycsbc::ClientThread, dbs[i], &wl,
-                                             thread_ops, true, true, !do_transaction, &latch));
+      monitor_db->ReleaseSnapshot();
+    }
+    if (space_stats && monitor_db->GetSpaceStats(space_before) != ycsbc::DB::kOK) {
+      std::cerr << "The DB does not report its space usage" << std::endl;
+      exit(1);
+    }
+    CountDownLatch reader_stop(1);
+    std::future<int> reader_future;
+    if (long_reader) {
+      reader_future = std::async(std::launch::async, LongReaderThread, monitor_db, &reader_stop,
+                                 hold_time);
     }
-    assert((int)client_threads.size() == num_threads);
 
-    int sum = 0;
-    for (auto &n : client_threads) {
-      assert(n.valid());
-      sum += n.get();
+    RunPhase(groups, false, !do_load || separate_load, true, show_status, status_interval);
+    if (separate_load) {
+      for (ClientGroup *group : load_groups) {
+        for (ycsbc::DB *db : group->dbs) {
+          db->Cleanup();
+        }
+      }
     }
-    double runtime = timer.End();
 
-    if (show_status) {
-      status_future.wait();
+    if (long_reader) {
+      reader_stop.CountDown();
+      std::cout << "Long reader snapshots: " << reader_future.get() << std::endl;
     }
+    if (space_stats) {
+      std::map<std::string, uint64_t> space_after;
+      monitor_db->GetSpaceStats(space_after);
+      PrintSpaceStats(space_before, space_after);
+    }
+    if (monitor_db != nullptr) {
+      monitor_db->Cleanup();
+      delete monitor_db;
+    }
+  }
 
-    std::cout << "Load runtime(sec): " << runtime << std::endl;
-    std::cout << "Load operations(ops): " << sum << std::endl;
-    std::cout << "Load throughput(ops/sec): " << sum / runtime << std::endl;
+  if (separate_load) {
+    groups.insert(groups.end(), load_groups.begin(), load_groups.end());
   }
+  for (ClientGroup *group : groups) {
+    for (ycsbc::DB *db : group->dbs) {
+      delete db;
+    }
+    delete group->wl;
+    delete group->measurements;
+    delete group;
+  }
+}
 
-  measurements->Reset();
-  std::this_thread::sleep_for(std::chrono::seconds(stoi(props.GetProperty("sleepafterload", "0"))));
+ClientGroup *CreateClientGroup(const std::string &name, const ycsbc::utils::Properties &props) {
+  ClientGroup *group = new ClientGroup;
+  group->name = name;
+  group->props = props;
+  if (!name.empty()) {
+    group->props.Merge(props, "group." + name + ".");
+  }
 
-  // transaction phase
-  if (do_transaction) {
-    const int total_ops = stoi(props[ycsbc::CoreWorkload::OPERATION_COUNT_PROPERTY]);
+  group->num_threads = stoi(group->props.GetProperty("threadcount", "1"));
+  group->target = std::stod(group->props.GetProperty("target", "0"));
 
-    CountDownLatch latch(num_threads);
-    ycsbc::utils::Timer<double> timer;
+  group->measurements = ycsbc::CreateMeasurements(&group->props);
+  if (group->measurements == nullptr) {
+    std::cerr << "Unknown measurements name" << std::endl;
+    exit(1);
+  }
 
-    timer.Start();
-    std::future<void> status_future;
-    if (show_status) {
-      status_future = std::async(std::launch::async, StatusThread,
-                                 measurements, &latch, status_interval);
-    }
-    std::vector<std::future<int>> client_threads;
-    for (int i = 0; i < num_threads; ++i) {
-      int thread_ops = total_ops / num_threads;
-      if (i < total_ops % num_threads) {
-        thread_ops++;
-      }
-      client_threads.emplace_back(std::async(std::launch::async, ycsbc::ClientThread, dbs[i], &wl,
-                                             thread_ops, false, !do_load, true,  &latch));
+  for (int i = 0; i < group->num_threads; i++) {
+    ycsbc::DB *db = ycsbc::DBFactory::CreateDB(&group->props, group->measurements);
+    if (db == nullptr) {
+      std::cerr << "Unknown database name " << group->props["dbname"] << std::endl;
+      exit(1);
     }
-    assert((int)client_threads.size() == num_threads);
+    group->dbs.push_back(db);
+  }
 
-    int sum = 0;
-    for (auto &n : client_threads) {
-      assert(n.valid());
-      sum += n.get();
-    }
-    double runtime = timer.End();
+  group->wl = ycsbc::WorkloadFactory::CreateWorkload(group->props);
+  if (group->wl == nullptr) {
+    std::cerr << "Unknown workload name " << group->props["workload"] << std::endl;
+    exit(1);
+  }
+  group->wl->SetMeasurements(group->measurements);
+  group->wl->Init(group->props);
+  return group;
+}
 
-    if (show_status) {
-      status_future.wait();
+std::vector<ClientGroup *> CreateClientGroups(const ycsbc::utils::Properties &props) {
+  // "clientgroups" lists the group names; each group takes the global properties
+  // overridden by the ones prefixed with "group.<name>."
+  std::vector<std::string> names;
+  std::string list = props.GetProperty("clientgroups", "");
+  size_t pos = 0;
+  while (pos <= list.size() && !list.empty()) {
+    size_t comma = list.find(',', pos);
+    if (comma == std::string::npos) {
+      comma = list.size();
+    }
+    std::string name = ycsbc::utils::Trim(list.substr(pos, comma - pos));
+    if (!name.empty()) {
+      names.push_back(name);
     }
+    pos = comma + 1;
+  }
+  if (names.empty()) {
+    names.push_back("");
+  }
 
-    std::cout << "Run runtime(sec): " << runtime << std::endl;
-    std::cout << "Run operations(ops): " << sum << std::endl;
-    std::cout << "Run throughput(ops/sec): " << sum / runtime << std::endl;
+  std::vector<ClientGroup *> groups;
+  for (const std::string &name : names) {
+    groups.push_back(CreateClientGroup(name, props));
   }
+  return groups;
+}
 
-  for (int i = 0; i < num_threads; i++) {
-    delete dbs[i];
+std::vector<ClientGroup *> CreateLoadGroups(const std::vector<ClientGroup *> &groups,
+                                            const ycsbc::utils::Properties &props) {
+  // the properties that shape the loaded records; groups agreeing on all of them share a load,
+  // which otherwise runs with the global properties
+  const std::string load_properties[] = {
+    "workload",
+    ycsbc::CoreWorkload::TABLENAME_PROPERTY,
+    ycsbc::CoreWorkload::TABLE_COUNT_PROPERTY,
+    ycsbc::CoreWorkload::RECORD_COUNT_PROPERTY,
+    ycsbc::CoreWorkload::INSERT_START_PROPERTY,
+    ycsbc::CoreWorkload::INSERT_ORDER_PROPERTY,
+    ycsbc::CoreWorkload::ZERO_PADDING_PROPERTY,
+    ycsbc::CoreWorkload::FIELD_COUNT_PROPERTY,
+    ycsbc::CoreWorkload::FIELD_COUNT_DISTRIBUTION_PROPERTY,
+    ycsbc::CoreWorkload::FIELD_COUNT_HISTOGRAM_PROPERTY,
+    ycsbc::CoreWorkload::FIELD_LENGTH_PROPERTY,
+    ycsbc::CoreWorkload::FIELD_LENGTH_DISTRIBUTION_PROPERTY,
+    ycsbc::CoreWorkload::FIELD_LENGTH_HISTOGRAM_PROPERTY,
+    ycsbc::CoreWorkload::FIELD_NAME_PREFIX,
+  };
+  std::set<std::map<std::string, std::string>> loads;
+  std::vector<ClientGroup *> load_groups;
+  for (ClientGroup *group : groups) {
+    std::map<std::string, std::string> load;
+    for (const std::string &property : load_properties) {
+      if (group->props.ContainsKey(property)) {
+        load[property] = group->props[property];
+      }
+    }
+    if (!loads.insert(load).second) {
+      continue;
+    }
+    ycsbc::utils::Properties load_props = props;
+    for (const auto &property : load) {
+      load_props.SetProperty(property.first, property.second);
+    }
+    ClientGroup *load_group = CreateClientGroup("", load_props);
+    load_group->name = group->name;
+    load_groups.push_back(load_group);
   }
+  return load_groups;
 }
 
 void ParseCommandLine(int argc, const char *argv[], ycsbc::utils::Properties &props) {
@@ -264,7 +504,16 @@ void UsageMessage(const char *command) {
       "  -p name=value: specify a property to be passed to the DB and workloads\n"
       "                 multiple properties can be specified, and override any\n"
       "                 values in the propertyfile\n"
-      "  -s: print status every 10 seconds (use status.interval prop to override)"
+      "  -s: print status every 10 seconds (use status.interval prop to override)\n"
+      "Long readers:\n"
+      "  -p longreader=true: hold a snapshot during the transactions phase, replaced\n"
+      "                 every longreader.holdtime seconds (default: 0, never)\n"
+      "  -p spacestats=true: print the space used by the DB before and after the\n"
+      "                 transactions phase\n"
+      "Client groups:\n"
+      "  -p clientgroups=a,b runs groups a and b concurrently; each group uses the\n"
+      "                 global properties overridden by group.<name>.<property>\n"
+      "                 (e.g., group.a.threadcount=4, group.a.target=1000)"
       << std::endl;
 }
 
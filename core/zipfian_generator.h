@@ -50,7 +50,15 @@ class ZipfianGenerator : public Generator<uint64_t> {
 
   uint64_t Last();
 
+  ///
+  /// Returns the value a uniform draw u of [0, 1) maps to, e.g. to sample the
+  /// distribution at fixed quantiles.
+  ///
+  uint64_t ValueAt(double u) const { return ValueAt(u, count_for_zeta_); }
+
  private:
+  uint64_t ValueAt(double u, uint64_t num) const;
+
   double Eta() {
     return (1 - std::pow(2.0 / items_, 1 - theta_)) / (1 - zeta_2_ / zeta_n_);
   }
@@ -98,18 +106,21 @@ inline uint64_t ZipfianGenerator::Next(uint64_t num) {
     }
   }
 
-  double u = utils::ThreadLocalRandomDouble();
+  return last_value_ = ValueAt(utils::ThreadLocalRandomDouble(), num);
+}
+
+inline uint64_t ZipfianGenerator::ValueAt(double u, uint64_t num) const {
   double uz = u * zeta_n_;
 
   if (uz < 1.0) {
-    return last_value_ = base_;
+    return base_;
   }
 
   if (uz < 1.0 + std::pow(0.5, theta_)) {
-    return last_value_ = base_ + 1;
+    return base_ + 1;
   }
 
-  return last_value_ = base_ + num * std::pow(eta_ * u - eta_ + 1, alpha_);
+  return base_ + num * std::pow(eta_ * u - eta_ + 1, alpha_);
 }
 
 inline uint64_t ZipfianGenerator::Last() {
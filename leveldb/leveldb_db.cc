@@ -14,6 +14,8 @@
 #include <leveldb/options.h>
 #include <leveldb/write_batch.h>
 
+#include <algorithm>
+
 namespace {
   const std::string PROP_NAME = "leveldb.dbname";
   const std::string PROP_NAME_DEFAULT = "";
@@ -21,6 +23,9 @@ namespace {
   const std::string PROP_FORMAT = "leveldb.format";
   const std::string PROP_FORMAT_DEFAULT = "single";
 
+  const std::string PROP_MULTITABLE = "leveldb.multitable";
+  const std::string PROP_MULTITABLE_DEFAULT = "false";
+
   const std::string PROP_DESTROY = "leveldb.destroy";
   const std::string PROP_DESTROY_DEFAULT = "false";
 
@@ -47,6 +52,9 @@ namespace {
 
   const std::string PROP_BLOCK_RESTART_INTERVAL = "leveldb.block_restart_interval";
   const std::string PROP_BLOCK_RESTART_INTERVAL_DEFAULT = "0";
+
+  // keys deleted per write batch by range deletions, which LevelDB lacks
+  const int kDeleteRangeBatchSize = 1000;
 } // anonymous
 
 namespace ycsbc {
@@ -64,23 +72,32 @@ void LeveldbDB::Init() {
     format_ = kSingleEntry;
     method_read_ = &LeveldbDB::ReadSingleEntry;
     method_scan_ = &LeveldbDB::ScanSingleEntry;
+    method_scan_range_ = &LeveldbDB::ScanRangeSingleEntry;
+    method_full_scan_ = &LeveldbDB::FullScanSingleEntry;
     method_update_ = &LeveldbDB::UpdateSingleEntry;
     method_insert_ = &LeveldbDB::InsertSingleEntry;
     method_delete_ = &LeveldbDB::DeleteSingleEntry;
+    method_delete_range_ = &LeveldbDB::DeleteRangeSingleEntry;
   } else if (format == "row") {
     format_ = kRowMajor;
     method_read_ = &LeveldbDB::ReadCompKeyRM;
     method_scan_ = &LeveldbDB::ScanCompKeyRM;
+    method_scan_range_ = nullptr;
+    method_full_scan_ = nullptr;
     method_update_ = &LeveldbDB::InsertCompKey;
     method_insert_ = &LeveldbDB::InsertCompKey;
     method_delete_ = &LeveldbDB::DeleteCompKey;
+    method_delete_range_ = nullptr;
   } else if (format == "column") {
     format_ = kColumnMajor;
     method_read_ = &LeveldbDB::ReadCompKeyCM;
     method_scan_ = &LeveldbDB::ScanCompKeyCM;
+    method_scan_range_ = nullptr;
+    method_full_scan_ = nullptr;
     method_update_ = &LeveldbDB::InsertCompKey;
     method_insert_ = &LeveldbDB::InsertCompKey;
     method_delete_ = &LeveldbDB::DeleteCompKey;
+    method_delete_range_ = nullptr;
   } else {
     throw utils::Exception("unknown format");
   }
@@ -88,6 +105,7 @@ void LeveldbDB::Init() {
                                             CoreWorkload::FIELD_COUNT_DEFAULT));
   field_prefix_ = props.GetProperty(CoreWorkload::FIELD_NAME_PREFIX,
                                     CoreWorkload::FIELD_NAME_PREFIX_DEFAULT);
+  multitable_ = props.GetProperty(PROP_MULTITABLE, PROP_MULTITABLE_DEFAULT) == "true";
 
   ref_cnt_++;
   if (db_) {
@@ -118,6 +136,8 @@ void LeveldbDB::Init() {
 }
 
 void LeveldbDB::Cleanup() {
+  ReleaseSnapshot();
+
   const std::lock_guard<std::mutex> lock(mu_);
   if (--ref_cnt_) {
     return;
@@ -186,8 +206,9 @@ void LeveldbDB::DeserializeRowFilter(std::vector<Field> *values, const std::stri
   const char *p = data.data();
   const char *lim = p + data.size();
 
-  std::vector<std::string>::const_iterator filter_iter = fields.begin();
-  while (p != lim && filter_iter != fields.end()) {
+  // records may lack some of the fields
+  size_t found = 0;
+  while (p != lim && found < fields.size()) {
     assert(p < lim);
     uint32_t len = *reinterpret_cast<const uint32_t *>(p);
     p += sizeof(uint32_t);
@@ -195,14 +216,12 @@ void LeveldbDB::DeserializeRowFilter(std::vector<Field> *values, const std::stri
     p += len;
     len = *reinterpret_cast<const uint32_t *>(p);
     p += sizeof(uint32_t);
-    std::string value(p, static_cast<const size_t>(len));
-    p += len;
-    if (*filter_iter == field) {
-      values->push_back({field, value});
-      filter_iter++;
+    if (std::find(fields.begin(), fields.end(), field) != fields.end()) {
+      values->push_back({field, std::string(p, static_cast<const size_t>(len))});
+      found++;
     }
+    p += len;
   }
-  assert(values->size() == fields.size());
 }
 
 void LeveldbDB::DeserializeRow(std::vector<Field> *values, const std::string &data) {
@@ -220,7 +239,23 @@ void LeveldbDB::DeserializeRow(std::vector<Field> *values, const std::string &da
     p += len;
     values->push_back({field, value});
   }
-  assert(values->size() == fieldcount_);
+}
+
+std::string LeveldbDB::TablePrefix(const std::string &table) const {
+  // tables share one keyspace, separated by a "<table>/" key prefix
+  return multitable_ ? table + "/" : std::string();
+}
+
+std::string LeveldbDB::TableKey(const std::string &table, const std::string &key) const {
+  return multitable_ ? TablePrefix(table).append(key) : key;
+}
+
+std::string LeveldbDB::TableEndKey(const std::string &table, const std::string &key) const {
+  if (!key.empty() || !multitable_) {
+    return TableKey(table, key);
+  }
+  // no upper bound within the table: end at the first key after its prefix
+  return table + static_cast<char>('/' + 1);
 }
 
 std::string LeveldbDB::BuildCompKey(const std::string &key, const std::string &field_name) {
@@ -269,9 +304,10 @@ DB::Status LeveldbDB::ReadSingleEntry(const std::string &table, const std::strin
 DB::Status LeveldbDB::ScanSingleEntry(const std::string &table, const std::string &key, int len,
                                       const std::vector<std::string> *fields,
                                       std::vector<std::vector<Field>> &result) {
+  const std::string prefix = TablePrefix(table);
   leveldb::Iterator *db_iter = db_->NewIterator(leveldb::ReadOptions());
   db_iter->Seek(key);
-  for (int i = 0; db_iter->Valid() && i < len; i++) {
+  for (int i = 0; db_iter->Valid() && db_iter->key().starts_with(prefix) && i < len; i++) {
     std::string data = db_iter->value().ToString();
     result.push_back(std::vector<Field>());
     std::vector<Field> &values = result.back();
@@ -286,6 +322,73 @@ DB::Status LeveldbDB::ScanSingleEntry(const std::string &table, const std::strin
   return kOK;
 }
 
+DB::Status LeveldbDB::ScanRangeSingleEntry(const std::string &table,
+                                           const std::string &start_key,
+                                           const std::string &end_key, int len, bool reverse,
+                                           const std::vector<std::string> *fields,
+                                           std::vector<std::vector<Field>> &result) {
+  leveldb::Iterator *db_iter = db_->NewIterator(leveldb::ReadOptions());
+  if (!reverse) {
+    db_iter->Seek(start_key);
+  } else if (end_key.empty()) {
+    db_iter->SeekToLast();
+  } else {
+    // the last key before end_key
+    db_iter->Seek(end_key);
+    if (db_iter->Valid()) {
+      db_iter->Prev();
+    } else {
+      db_iter->SeekToLast();
+    }
+  }
+  for (int i = 0; db_iter->Valid() && i < len; i++) {
+    if (reverse ? db_iter->key().compare(start_key) < 0
+                : !end_key.empty() && db_iter->key().compare(end_key) >= 0) {
+      break;
+    }
+    std::string data = db_iter->value().ToString();
+    result.push_back(std::vector<Field>());
+    std::vector<Field> &values = result.back();
+    if (fields != nullptr) {
+      DeserializeRowFilter(&values, data, *fields);
+    } else {
+      DeserializeRow(&values, data);
+    }
+    if (reverse) {
+      db_iter->Prev();
+    } else {
+      db_iter->Next();
+    }
+  }
+  delete db_iter;
+  return kOK;
+}
+
+DB::Status LeveldbDB::FullScanSingleEntry(const std::string &table,
+                                          const std::string &start_key,
+                                          const std::string &end_key, uint64_t &records,
+                                          uint64_t &bytes) {
+  leveldb::ReadOptions ropt;
+  // a one-off pass over the table would only evict the working set
+  ropt.fill_cache = false;
+  leveldb::Iterator *db_iter = db_->NewIterator(ropt);
+  records = 0;
+  bytes = 0;
+  for (db_iter->Seek(start_key); db_iter->Valid(); db_iter->Next()) {
+    if (!end_key.empty() && db_iter->key().compare(end_key) >= 0) {
+      break;
+    }
+    records++;
+    bytes += db_iter->key().size() + db_iter->value().size();
+  }
+  leveldb::Status s = db_iter->status();
+  delete db_iter;
+  if (!s.ok()) {
+    throw utils::Exception(std::string("LevelDB FullScan: ") + s.ToString());
+  }
+  return kOK;
+}
+
 DB::Status LeveldbDB::UpdateSingleEntry(const std::string &table, const std::string &key,
                                         std::vector<Field> &values) {
   std::string data;
@@ -298,7 +401,7 @@ DB::Status LeveldbDB::UpdateSingleEntry(const std::string &table, const std::str
   std::vector<Field> current_values;
   DeserializeRow(&current_values, data);
   for (Field &new_field : values) {
-    bool found __attribute__((unused)) = false;
+    bool found = false;
     for (Field &cur_field : current_values) {
       if (cur_field.name == new_field.name) {
         found = true;
@@ -306,7 +409,9 @@ DB::Status LeveldbDB::UpdateSingleEntry(const std::string &table, const std::str
         break;
       }
     }
-    assert(found);
+    if (!found) {
+      current_values.push_back(new_field);
+    }
   }
   leveldb::WriteOptions wopt;
 
@@ -340,44 +445,56 @@ DB::Status LeveldbDB::DeleteSingleEntry(const std::string &table, const std::str
   return kOK;
 }
 
+DB::Status LeveldbDB::DeleteRangeSingleEntry(const std::string &table,
+                                             const std::string &start_key,
+                                             const std::string &end_key) {
+  leveldb::WriteOptions wopt;
+  leveldb::WriteBatch batch;
+  int batch_size = 0;
+  leveldb::Iterator *db_iter = db_->NewIterator(leveldb::ReadOptions());
+  for (db_iter->Seek(start_key); db_iter->Valid(); db_iter->Next()) {
+    if (!end_key.empty() && db_iter->key().compare(end_key) >= 0) {
+      break;
+    }
+    batch.Delete(db_iter->key());
+    if (++batch_size == kDeleteRangeBatchSize) {
+      leveldb::Status s = db_->Write(wopt, &batch);
+      if (!s.ok()) {
+        delete db_iter;
+        throw utils::Exception(std::string("LevelDB Write: ") + s.ToString());
+      }
+      batch.Clear();
+      batch_size = 0;
+    }
+  }
+  delete db_iter;
+  leveldb::Status s = db_->Write(wopt, &batch);
+  if (!s.ok()) {
+    throw utils::Exception(std::string("LevelDB Write: ") + s.ToString());
+  }
+  return kOK;
+}
+
 DB::Status LeveldbDB::ReadCompKeyRM(const std::string &table, const std::string &key,
                                     const std::vector<std::string> *fields,
                                     std::vector<Field> &result) {
   leveldb::Iterator *db_iter = db_->NewIterator(leveldb::ReadOptions());
-  db_iter->Seek(key);
+  db_iter->Seek(BuildCompKey(key, ""));
   if (!db_iter->Valid() || KeyFromCompKey(db_iter->key().ToString()) != key) {
+    delete db_iter;
     return kNotFound;
   }
-  if (fields != nullptr) {
-    std::vector<std::string>::const_iterator filter_iter = fields->begin();
-    for (int i = 0; i < fieldcount_ && filter_iter != fields->end() && db_iter->Valid(); i++) {
-      std::string comp_key = db_iter->key().ToString();
-      std::string cur_val = db_iter->value().ToString();
-      std::string cur_key = KeyFromCompKey(comp_key);
-      std::string cur_field = FieldFromCompKey(comp_key);
-      assert(cur_key == key);
-      assert(cur_field == field_prefix_ + std::to_string(i));
-
-      if (cur_field == *filter_iter) {
-        result.push_back({cur_field, cur_val});
-        filter_iter++;
-      }
-      db_iter->Next();
+  // records may lack some of the fields
+  for (; db_iter->Valid(); db_iter->Next()) {
+    std::string comp_key = db_iter->key().ToString();
+    if (KeyFromCompKey(comp_key) != key) {
+      break;
     }
-    assert(result.size() == fields->size());
-  } else {
-    for (int i = 0; i < fieldcount_ && db_iter->Valid(); i++) {
-      std::string comp_key = db_iter->key().ToString();
-      std::string cur_val = db_iter->value().ToString();
-      std::string cur_key = KeyFromCompKey(comp_key);
-      std::string cur_field = FieldFromCompKey(comp_key);
-      assert(cur_key == key);
-      assert(cur_field == field_prefix_ + std::to_string(i));
-
-      result.push_back({cur_field, cur_val});
-      db_iter->Next();
+    std::string cur_field = FieldFromCompKey(comp_key);
+    if (fields == nullptr ||
+        std::find(fields->begin(), fields->end(), cur_field) != fields->end()) {
+      result.push_back({cur_field, db_iter->value().ToString()});
     }
-    assert(result.size() == fieldcount_);
   }
   delete db_iter;
   return kOK;
@@ -386,40 +503,23 @@ DB::Status LeveldbDB::ReadCompKeyRM(const std::string &table, const std::string
 DB::Status LeveldbDB::ScanCompKeyRM(const std::string &table, const std::string &key, int len,
                                     const std::vector<std::string> *fields,
                                     std::vector<std::vector<Field>> &result) {
+  const std::string prefix = TablePrefix(table);
   leveldb::Iterator *db_iter = db_->NewIterator(leveldb::ReadOptions());
-  db_iter->Seek(key);
-  assert(db_iter->Valid() && KeyFromCompKey(db_iter->key().ToString()) == key);
-  for (int i = 0; i < len && db_iter->Valid(); i++) {
+  db_iter->Seek(BuildCompKey(key, ""));
+  for (int i = 0; i < len && db_iter->Valid() && db_iter->key().starts_with(prefix); i++) {
     result.push_back(std::vector<Field>());
     std::vector<Field> &values = result.back();
-    if (fields != nullptr) {
-      std::vector<std::string>::const_iterator filter_iter = fields->begin();
-      for (int j = 0; j < fieldcount_ && filter_iter != fields->end() && db_iter->Valid(); j++) {
-        std::string comp_key = db_iter->key().ToString();
-        std::string cur_val = db_iter->value().ToString();
-        std::string cur_key = KeyFromCompKey(comp_key);
-        std::string cur_field = FieldFromCompKey(comp_key);
-        assert(cur_field == field_prefix_ + std::to_string(j));
-
-        if (cur_field == *filter_iter) {
-          values.push_back({cur_field, cur_val});
-          filter_iter++;
-        }
-        db_iter->Next();
+    const std::string cur_key = KeyFromCompKey(db_iter->key().ToString());
+    for (; db_iter->Valid(); db_iter->Next()) {
+      std::string comp_key = db_iter->key().ToString();
+      if (KeyFromCompKey(comp_key) != cur_key) {
+        break;
       }
-      assert(values.size() == fields->size());
-    } else {
-      for (int j = 0; j < fieldcount_ && db_iter->Valid(); j++) {
-        std::string comp_key = db_iter->key().ToString();
-        std::string cur_val = db_iter->value().ToString();
-        std::string cur_key = KeyFromCompKey(comp_key);
-        std::string cur_field = FieldFromCompKey(comp_key);
-        assert(cur_field == field_prefix_ + std::to_string(j));
-
-        values.push_back({cur_field, cur_val});
-        db_iter->Next();
+      std::string cur_field = FieldFromCompKey(comp_key);
+      if (fields == nullptr ||
+          std::find(fields->begin(), fields->end(), cur_field) != fields->end()) {
+        values.push_back({cur_field, db_iter->value().ToString()});
       }
-      assert(values.size() == fieldcount_);
     }
   }
   delete db_iter;
@@ -473,6 +573,34 @@ DB::Status LeveldbDB::DeleteCompKey(const std::string &table, const std::string
   return kOK;
 }
 
+DB::Status LeveldbDB::HoldSnapshot() {
+  ReleaseSnapshot();
+  snapshot_ = db_->GetSnapshot();
+  return kOK;
+}
+
+DB::Status LeveldbDB::ReleaseSnapshot() {
+  if (snapshot_ != nullptr) {
+    db_->ReleaseSnapshot(snapshot_);
+    snapshot_ = nullptr;
+  }
+  return kOK;
+}
+
+DB::Status LeveldbDB::GetSpaceStats(std::map<std::string, uint64_t> &stats) {
+  // the table files over the whole key space
+  const std::string limit(16, '\xff');
+  leveldb::Range range("", limit);
+  uint64_t size;
+  db_->GetApproximateSizes(&range, 1, &size);
+  stats["leveldb.approximate-size"] = size;
+  std::string value;
+  if (db_->GetProperty("leveldb.approximate-memory-usage", &value)) {
+    stats["leveldb.approximate-memory-usage"] = std::stoull(value);
+  }
+  return kOK;
+}
+
 DB *NewLeveldbDB() {
   return new LeveldbDB;
 }
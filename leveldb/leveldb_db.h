@@ -9,6 +9,7 @@
 #define YCSB_C_LEVELDB_DB_H_
 
 #include <iostream>
+#include <map>
 #include <string>
 #include <mutex>
 
@@ -25,7 +26,7 @@ namespace ycsbc {
 
 class LeveldbDB : public DB {
  public:
-  LeveldbDB() {}
+  LeveldbDB() : snapshot_(nullptr) {}
   ~LeveldbDB() {}
 
   void Init();
@@ -34,26 +35,60 @@ class LeveldbDB : public DB {
 
   Status Read(const std::string &table, const std::string &key,
               const std::vector<std::string> *fields, std::vector<Field> &result) {
-    return (this->*(method_read_))(table, key, fields, result);
+    return (this->*(method_read_))(table, TableKey(table, key), fields, result);
   }
 
   Status Scan(const std::string &table, const std::string &key, int len,
               const std::vector<std::string> *fields, std::vector<std::vector<Field>> &result) {
-    return (this->*(method_scan_))(table, key, len, fields, result);
+    return (this->*(method_scan_))(table, TableKey(table, key), len, fields, result);
+  }
+
+  Status ScanRange(const std::string &table, const std::string &start_key,
+                   const std::string &end_key, int len, bool reverse,
+                   const std::vector<std::string> *fields,
+                   std::vector<std::vector<Field>> &result) {
+    if (method_scan_range_ == nullptr) {
+      return kNotImplemented;
+    }
+    return (this->*(method_scan_range_))(table, TableKey(table, start_key),
+                                         TableEndKey(table, end_key), len, reverse, fields,
+                                         result);
+  }
+
+  Status FullScan(const std::string &table, const std::string &start_key,
+                  const std::string &end_key, uint64_t &records, uint64_t &bytes) {
+    if (method_full_scan_ == nullptr) {
+      return kNotImplemented;
+    }
+    return (this->*(method_full_scan_))(table, TableKey(table, start_key),
+                                        TableEndKey(table, end_key), records, bytes);
   }
 
   Status Update(const std::string &table, const std::string &key, std::vector<Field> &values) {
-    return (this->*(method_update_))(table, key, values);
+    return (this->*(method_update_))(table, TableKey(table, key), values);
   }
 
   Status Insert(const std::string &table, const std::string &key, std::vector<Field> &values) {
-    return (this->*(method_insert_))(table, key, values);
+    return (this->*(method_insert_))(table, TableKey(table, key), values);
   }
 
   Status Delete(const std::string &table, const std::string &key) {
-    return (this->*(method_delete_))(table, key);
+    return (this->*(method_delete_))(table, TableKey(table, key));
   }
 
+  Status DeleteRange(const std::string &table, const std::string &start_key,
+                     const std::string &end_key) {
+    if (method_delete_range_ == nullptr) {
+      return kNotImplemented;
+    }
+    return (this->*(method_delete_range_))(table, TableKey(table, start_key),
+                                           TableEndKey(table, end_key));
+  }
+
+  Status HoldSnapshot();
+  Status ReleaseSnapshot();
+  Status GetSpaceStats(std::map<std::string, uint64_t> &stats);
+
  private:
   enum LdbFormat {
     kSingleEntry,
@@ -67,6 +102,9 @@ class LeveldbDB : public DB {
   void DeserializeRowFilter(std::vector<Field> *values, const std::string &data,
                             const std::vector<std::string> &fields);
   void DeserializeRow(std::vector<Field> *values, const std::string &data);
+  std::string TablePrefix(const std::string &table) const;
+  std::string TableKey(const std::string &table, const std::string &key) const;
+  std::string TableEndKey(const std::string &table, const std::string &key) const;
   std::string BuildCompKey(const std::string &key, const std::string &field_name);
   std::string KeyFromCompKey(const std::string &comp_key);
   std::string FieldFromCompKey(const std::string &comp_key);
@@ -76,11 +114,19 @@ class LeveldbDB : public DB {
   Status ScanSingleEntry(const std::string &table, const std::string &key, int len,
                          const std::vector<std::string> *fields,
                          std::vector<std::vector<Field>> &result);
+  Status ScanRangeSingleEntry(const std::string &table, const std::string &start_key,
+                              const std::string &end_key, int len, bool reverse,
+                              const std::vector<std::string> *fields,
+                              std::vector<std::vector<Field>> &result);
+  Status FullScanSingleEntry(const std::string &table, const std::string &start_key,
+                             const std::string &end_key, uint64_t &records, uint64_t &bytes);
   Status UpdateSingleEntry(const std::string &table, const std::string &key,
                            std::vector<Field> &values);
   Status InsertSingleEntry(const std::string &table, const std::string &key,
                            std::vector<Field> &values);
   Status DeleteSingleEntry(const std::string &table, const std::string &key);
+  Status DeleteRangeSingleEntry(const std::string &table, const std::string &start_key,
+                                const std::string &end_key);
 
   Status ReadCompKeyRM(const std::string &table, const std::string &key,
                        const std::vector<std::string> *fields, std::vector<Field> &result);
@@ -101,14 +147,24 @@ class LeveldbDB : public DB {
   Status (LeveldbDB::*method_scan_)(const std::string &, const std::string &, int,
                                     const std::vector<std::string> *,
                                     std::vector<std::vector<Field>> &);
+  Status (LeveldbDB::*method_scan_range_)(const std::string &, const std::string &,
+                                          const std::string &, int, bool,
+                                          const std::vector<std::string> *,
+                                          std::vector<std::vector<Field>> &);
+  Status (LeveldbDB::*method_full_scan_)(const std::string &, const std::string &,
+                                         const std::string &, uint64_t &, uint64_t &);
   Status (LeveldbDB::*method_update_)(const std::string &, const std::string &,
                                       std::vector<Field> &);
   Status (LeveldbDB::*method_insert_)(const std::string &, const std::string &,
                                       std::vector<Field> &);
   Status (LeveldbDB::*method_delete_)(const std::string &, const std::string &);
+  Status (LeveldbDB::*method_delete_range_)(const std::string &, const std::string &,
+                                            const std::string &);
 
   int fieldcount_;
   std::string field_prefix_;
+  bool multitable_;
+  const leveldb::Snapshot *snapshot_;
 
   static leveldb::DB *db_;
   static int ref_cnt_;
@@ -16,6 +16,8 @@
 
 #include <lmdb.h>
 
+#include <algorithm>
+
 namespace {
   const std::string PROP_DBPATH = "lmdb.dbpath";
   const std::string PROP_DBPATH_DEFAULT = "";
@@ -23,6 +25,12 @@ namespace {
   const std::string PROP_FORMAT = "lmdb.format";
   const std::string PROP_FORMAT_DEFAULT = "single";
 
+  const std::string PROP_MULTITABLE = "lmdb.multitable";
+  const std::string PROP_MULTITABLE_DEFAULT = "false";
+
+  const std::string PROP_MAXDBS = "lmdb.maxdbs";
+  const std::string PROP_MAXDBS_DEFAULT = "128";
+
   const std::string PROP_MAPSIZE = "lmdb.mapsize";
   const std::string PROP_MAPSIZE_DEFAULT = "-1";
 
@@ -43,6 +51,8 @@ namespace ycsbc {
 
 MDB_env *LmdbDB::env_;
 MDB_dbi LmdbDB::dbi_;
+bool LmdbDB::multitable_ = false;
+std::map<std::string, MDB_dbi> LmdbDB::dbis_;
 int LmdbDB::ref_cnt_ = 0;
 std::mutex LmdbDB::mutex_;
 
@@ -55,9 +65,13 @@ void LmdbDB::Init() {
     format_ = kSingleEntry;
     method_read_ = &LmdbDB::ReadSingleEntry;
     method_scan_ = &LmdbDB::ScanSingleEntry;
+    method_scan_range_ = &LmdbDB::ScanRangeSingleEntry;
+    method_full_scan_ = &LmdbDB::FullScanSingleEntry;
     method_update_ = &LmdbDB::UpdateSingleEntry;
     method_insert_ = &LmdbDB::InsertSingleEntry;
     method_delete_ = &LmdbDB::DeleteSingleEntry;
+    method_delete_range_ = &LmdbDB::DeleteRangeSingleEntry;
+    method_increment_ = &LmdbDB::IncrementSingleEntry;
   } else {
     throw utils::Exception("unknown format");
   }
@@ -88,6 +102,15 @@ void LmdbDB::Init() {
   if  (ret) {
     throw utils::Exception(std::string("Init mdb_env_create: ") + mdb_strerror(ret));
   }
+  // each table is stored in the named database of the same name
+  multitable_ = props.GetProperty(PROP_MULTITABLE, PROP_MULTITABLE_DEFAULT) == "true";
+  if (multitable_) {
+    unsigned max_dbs = std::stoul(props.GetProperty(PROP_MAXDBS, PROP_MAXDBS_DEFAULT));
+    ret = mdb_env_set_maxdbs(env_, max_dbs);
+    if (ret) {
+      throw utils::Exception(std::string("Init mdb_env_set_maxdbs: ") + mdb_strerror(ret));
+    }
+  }
   size_t map_size = std::stoul(props.GetProperty(PROP_MAPSIZE, PROP_MAPSIZE_DEFAULT));
   if (map_size >= 0) {
     ret = mdb_env_set_mapsize(env_, map_size);
@@ -124,14 +147,55 @@ void LmdbDB::Init() {
 }
 
 void LmdbDB::Cleanup() {
+  ReleaseSnapshot();
+
   const std::lock_guard<std::mutex> lock(mutex_);
   if (--ref_cnt_) {
     return;
   }
+  for (auto &entry : dbis_) {
+    mdb_close(env_, entry.second);
+  }
+  dbis_.clear();
   mdb_close(env_, dbi_);
   mdb_env_close(env_);
 }
 
+MDB_dbi LmdbDB::GetDbi(const std::string &table) {
+  if (!multitable_) {
+    return dbi_;
+  }
+  auto it = dbi_cache_.find(table);
+  if (it != dbi_cache_.end()) {
+    return it->second;
+  }
+
+  // named databases must be opened by one transaction at a time
+  const std::lock_guard<std::mutex> lock(mutex_);
+  MDB_dbi dbi;
+  auto global_it = dbis_.find(table);
+  if (global_it != dbis_.end()) {
+    dbi = global_it->second;
+  } else {
+    MDB_txn *txn;
+    int ret = mdb_txn_begin(env_, nullptr, 0, &txn);
+    if (ret) {
+      throw utils::Exception(std::string("GetDbi mdb_txn_begin: ") + mdb_strerror(ret));
+    }
+    ret = mdb_dbi_open(txn, table.c_str(), MDB_CREATE, &dbi);
+    if (ret) {
+      throw utils::Exception(std::string("GetDbi mdb_dbi_open: ") + mdb_strerror(ret));
+    }
+    ret = mdb_txn_commit(txn);
+    if (ret) {
+      throw utils::Exception(std::string("GetDbi mdb_txn_commit: ") + mdb_strerror(ret));
+    }
+    dbis_[table] = dbi;
+  }
+  dbi_cache_[table] = dbi;
+  return dbi;
+}
+
 void LmdbDB::SerializeRow(const std::vector<Field> &values, std::string *data) {
   for (const Field &field : values) {
     uint32_t len = field.name.size();
@@ -147,8 +211,9 @@ void LmdbDB::DeserializeRowFilter(std::vector<Field> *values, const char *data_p
                                   const std::vector<std::string> &fields) {
   const char *p = data_ptr;
   const char *lim = p + data_len;
-  std::vector<std::string>::const_iterator filter_iter = fields.begin();
-  while (p != lim && filter_iter != fields.end()) {
+  // records may lack some of the fields
+  size_t found = 0;
+  while (p != lim && found < fields.size()) {
     assert(p < lim);
     uint32_t len = *reinterpret_cast<const uint32_t *>(p);
     p += sizeof(uint32_t);
@@ -156,14 +221,12 @@ void LmdbDB::DeserializeRowFilter(std::vector<Field> *values, const char *data_p
     p += len;
     len = *reinterpret_cast<const uint32_t *>(p);
     p += sizeof(uint32_t);
-    std::string value(p, static_cast<const size_t>(len));
-    p += len;
-    if (*filter_iter == field) {
-      values->push_back({field, value});
-      filter_iter++;
+    if (std::find(fields.begin(), fields.end(), field) != fields.end()) {
+      values->push_back({field, std::string(p, static_cast<const size_t>(len))});
+      found++;
     }
+    p += len;
   }
-  assert(values->size() == fields.size());
 }
 
 void LmdbDB::DeserializeRow(std::vector<Field> *values, const char *data_ptr, size_t data_len) {
@@ -181,7 +244,6 @@ void LmdbDB::DeserializeRow(std::vector<Field> *values, const char *data_ptr, si
     p += len;
     values->push_back({field, value});
   }
-  assert(values->size() == fieldcount_);
 }
 
 DB::Status LmdbDB::ReadSingleEntry(const std::string &table, const std::string &key,
@@ -193,12 +255,17 @@ DB::Status LmdbDB::ReadSingleEntry(const std::string &table, const std::string &
   key_slice.mv_data = static_cast<void *>(const_cast<char *>(key.data()));
   key_slice.mv_size = key.size();
 
+  MDB_dbi dbi = GetDbi(table);
   int ret;
   ret = mdb_txn_begin(env_, nullptr, MDB_RDONLY, &txn);
   if (ret) {
     throw utils::Exception(std::string("Read mdb_txn_begin: ") + mdb_strerror(ret));
   }
-  ret = mdb_get(txn, dbi_, &key_slice, &val_slice);
+  ret = mdb_get(txn, dbi, &key_slice, &val_slice);
+  if (ret == MDB_NOTFOUND) {
+    mdb_txn_abort(txn);
+    return kNotFound;
+  }
   if (ret) {
     throw utils::Exception(std::string("Read mdb_get: ") + mdb_strerror(ret));
   }
@@ -222,18 +289,19 @@ DB::Status LmdbDB::ScanSingleEntry(const std::string &table, const std::string &
   key_slice.mv_data = static_cast<void *>(const_cast<char *>(key.data()));
   key_slice.mv_size = key.size();
 
+  MDB_dbi dbi = GetDbi(table);
   int ret;
   ret = mdb_txn_begin(env_, nullptr, 0, &txn);
   if (ret) {
     throw utils::Exception(std::string("Scan mdb_txn_begin: ") + mdb_strerror(ret));
   }
-  ret = mdb_cursor_open(txn, dbi_, &cursor);
+  ret = mdb_cursor_open(txn, dbi, &cursor);
   if (ret) {
     throw utils::Exception(std::string("Scan mdb_cursor_open: ") + mdb_strerror(ret));
   }
-  ret = mdb_cursor_get(cursor, &key_slice, &val_slice, MDB_SET);
-  assert(ret != MDB_NOTFOUND);
-  if (ret) {
+  // start at the first key not less than key, which need not exist
+  ret = mdb_cursor_get(cursor, &key_slice, &val_slice, MDB_SET_RANGE);
+  if (ret && ret != MDB_NOTFOUND) {
     throw utils::Exception(std::string("Scan mdb_cursor_get: ") + mdb_strerror(ret));
   }
   for (int i = 0; !ret && i < len; i++) {
@@ -252,6 +320,115 @@ DB::Status LmdbDB::ScanSingleEntry(const std::string &table, const std::string &
   return kOK;
 }
 
+DB::Status LmdbDB::ScanRangeSingleEntry(const std::string &table, const std::string &start_key,
+                                        const std::string &end_key, int len, bool reverse,
+                                        const std::vector<std::string> *fields,
+                                        std::vector<std::vector<Field>> &result) {
+  MDB_txn *txn;
+  MDB_cursor *cursor;
+  MDB_val key_slice, val_slice, start_slice, end_slice;
+
+  start_slice.mv_data = static_cast<void *>(const_cast<char *>(start_key.data()));
+  start_slice.mv_size = start_key.size();
+  end_slice.mv_data = static_cast<void *>(const_cast<char *>(end_key.data()));
+  end_slice.mv_size = end_key.size();
+
+  MDB_dbi dbi = GetDbi(table);
+  int ret;
+  ret = mdb_txn_begin(env_, nullptr, MDB_RDONLY, &txn);
+  if (ret) {
+    throw utils::Exception(std::string("ScanRange mdb_txn_begin: ") + mdb_strerror(ret));
+  }
+  ret = mdb_cursor_open(txn, dbi, &cursor);
+  if (ret) {
+    throw utils::Exception(std::string("ScanRange mdb_cursor_open: ") + mdb_strerror(ret));
+  }
+  // LMDB keys are never empty, so an empty bound starts at the first or last key
+  if (!reverse && start_key.empty()) {
+    ret = mdb_cursor_get(cursor, &key_slice, &val_slice, MDB_FIRST);
+  } else if (!reverse) {
+    key_slice = start_slice;
+    ret = mdb_cursor_get(cursor, &key_slice, &val_slice, MDB_SET_RANGE);
+  } else if (end_key.empty()) {
+    ret = mdb_cursor_get(cursor, &key_slice, &val_slice, MDB_LAST);
+  } else {
+    // the last key before end_key
+    key_slice = end_slice;
+    ret = mdb_cursor_get(cursor, &key_slice, &val_slice, MDB_SET_RANGE);
+    if (!ret) {
+      ret = mdb_cursor_get(cursor, &key_slice, &val_slice, MDB_PREV);
+    } else if (ret == MDB_NOTFOUND) {
+      ret = mdb_cursor_get(cursor, &key_slice, &val_slice, MDB_LAST);
+    }
+  }
+  if (ret && ret != MDB_NOTFOUND) {
+    throw utils::Exception(std::string("ScanRange mdb_cursor_get: ") + mdb_strerror(ret));
+  }
+  for (int i = 0; !ret && i < len; i++) {
+    if (reverse ? !start_key.empty() && mdb_cmp(txn, dbi, &key_slice, &start_slice) < 0
+                : !end_key.empty() && mdb_cmp(txn, dbi, &key_slice, &end_slice) >= 0) {
+      break;
+    }
+    result.push_back(std::vector<Field>());
+    std::vector<Field> &values = result.back();
+    if (fields != nullptr) {
+      DeserializeRowFilter(&values, static_cast<char *>(val_slice.mv_data), val_slice.mv_size,
+                           *fields);
+    } else {
+      DeserializeRow(&values, static_cast<char *>(val_slice.mv_data), val_slice.mv_size);
+    }
+    ret = mdb_cursor_get(cursor, &key_slice, &val_slice, reverse ? MDB_PREV : MDB_NEXT);
+  }
+  mdb_cursor_close(cursor);
+  mdb_txn_abort(txn);
+  return kOK;
+}
+
+DB::Status LmdbDB::FullScanSingleEntry(const std::string &table, const std::string &start_key,
+                                       const std::string &end_key, uint64_t &records,
+                                       uint64_t &bytes) {
+  MDB_txn *txn;
+  MDB_cursor *cursor;
+  MDB_val key_slice, val_slice, end_slice;
+
+  end_slice.mv_data = static_cast<void *>(const_cast<char *>(end_key.data()));
+  end_slice.mv_size = end_key.size();
+
+  MDB_dbi dbi = GetDbi(table);
+  int ret;
+  ret = mdb_txn_begin(env_, nullptr, MDB_RDONLY, &txn);
+  if (ret) {
+    throw utils::Exception(std::string("FullScan mdb_txn_begin: ") + mdb_strerror(ret));
+  }
+  ret = mdb_cursor_open(txn, dbi, &cursor);
+  if (ret) {
+    throw utils::Exception(std::string("FullScan mdb_cursor_open: ") + mdb_strerror(ret));
+  }
+  if (start_key.empty()) {
+    ret = mdb_cursor_get(cursor, &key_slice, &val_slice, MDB_FIRST);
+  } else {
+    key_slice.mv_data = static_cast<void *>(const_cast<char *>(start_key.data()));
+    key_slice.mv_size = start_key.size();
+    ret = mdb_cursor_get(cursor, &key_slice, &val_slice, MDB_SET_RANGE);
+  }
+  records = 0;
+  bytes = 0;
+  while (!ret) {
+    if (!end_key.empty() && mdb_cmp(txn, dbi, &key_slice, &end_slice) >= 0) {
+      break;
+    }
+    records++;
+    bytes += key_slice.mv_size + val_slice.mv_size;
+    ret = mdb_cursor_get(cursor, &key_slice, &val_slice, MDB_NEXT);
+  }
+  if (ret && ret != MDB_NOTFOUND) {
+    throw utils::Exception(std::string("FullScan mdb_cursor_get: ") + mdb_strerror(ret));
+  }
+  mdb_cursor_close(cursor);
+  mdb_txn_abort(txn);
+  return kOK;
+}
+
 DB::Status LmdbDB::UpdateSingleEntry(const std::string &table, const std::string &key,
                                      std::vector<Field> &values) {
   MDB_txn *txn;
@@ -260,19 +437,24 @@ DB::Status LmdbDB::UpdateSingleEntry(const std::string &table, const std::string
   key_slice.mv_data = static_cast<void *>(const_cast<char *>(key.data()));
   key_slice.mv_size = key.size();
 
+  MDB_dbi dbi = GetDbi(table);
   int ret;
   ret = mdb_txn_begin(env_, nullptr, 0, &txn);
   if (ret) {
     throw utils::Exception(std::string("Update mdb_txn_begin: ") + mdb_strerror(ret));
   }
-  ret = mdb_get(txn, dbi_, &key_slice, &val_slice);
+  ret = mdb_get(txn, dbi, &key_slice, &val_slice);
+  if (ret == MDB_NOTFOUND) {
+    mdb_txn_abort(txn);
+    return kNotFound;
+  }
   if (ret) {
     throw utils::Exception(std::string("Update mdb_get: ") + mdb_strerror(ret));
   }
   std::vector<Field> current_values;
   DeserializeRow(&current_values, static_cast<char *>(val_slice.mv_data), val_slice.mv_size);
   for (Field &new_field : values) {
-    bool found __attribute__((unused)) = false;
+    bool found = false;
     for (Field &cur_field : current_values) {
       if (cur_field.name == new_field.name) {
         found = true;
@@ -280,14 +462,16 @@ DB::Status LmdbDB::UpdateSingleEntry(const std::string &table, const std::string
         break;
       }
     }
-    assert(found);
+    if (!found) {
+      current_values.push_back(new_field);
+    }
   }
 
   std::string data;
   SerializeRow(current_values, &data);
   val_slice.mv_data = const_cast<char *>(data.data());
   val_slice.mv_size = data.size();
-  ret = mdb_put(txn, dbi_, &key_slice, &val_slice, 0);
+  ret = mdb_put(txn, dbi, &key_slice, &val_slice, 0);
   if (ret) {
     throw utils::Exception(std::string("Update mdb_put: ") + mdb_strerror(ret));
   }
@@ -312,12 +496,13 @@ DB::Status LmdbDB::InsertSingleEntry(const std::string &table, const std::string
   val_slice.mv_data = static_cast<void *>(const_cast<char *>(data.data()));
   val_slice.mv_size = data.size();
 
+  MDB_dbi dbi = GetDbi(table);
   int ret;
   ret = mdb_txn_begin(env_, nullptr, 0, &txn);
   if (ret) {
     throw utils::Exception(std::string("Insert mdb_txn_begin: ") + mdb_strerror(ret));
   }
-  ret = mdb_put(txn, dbi_, &key_slice, &val_slice, 0);
+  ret = mdb_put(txn, dbi, &key_slice, &val_slice, 0);
   if (ret) {
     throw utils::Exception(std::string("Insert mdb_put: ") + mdb_strerror(ret));
   }
@@ -335,12 +520,17 @@ DB::Status LmdbDB::DeleteSingleEntry(const std::string &table, const std::string
   key_slice.mv_data = static_cast<void *>(const_cast<char *>(key.data()));
   key_slice.mv_size = key.size();
 
+  MDB_dbi dbi = GetDbi(table);
   int ret;
   ret = mdb_txn_begin(env_, nullptr, 0, &txn);
   if (ret) {
     throw utils::Exception(std::string("Delete mdb_txn_begin: ") + mdb_strerror(ret));
   }
-  ret = mdb_del(txn, dbi_, &key_slice, nullptr);
+  ret = mdb_del(txn, dbi, &key_slice, nullptr);
+  if (ret == MDB_NOTFOUND) {
+    mdb_txn_abort(txn);
+    return kNotFound;
+  }
   if (ret) {
     throw utils::Exception(std::string("Delete mdb_del: ") + mdb_strerror(ret));
   }
@@ -351,6 +541,167 @@ DB::Status LmdbDB::DeleteSingleEntry(const std::string &table, const std::string
   return kOK;
 }
 
+DB::Status LmdbDB::DeleteRangeSingleEntry(const std::string &table, const std::string &start_key,
+                                          const std::string &end_key) {
+  MDB_txn *txn;
+  MDB_cursor *cursor;
+  MDB_val key_slice, val_slice, end_slice;
+
+  end_slice.mv_data = static_cast<void *>(const_cast<char *>(end_key.data()));
+  end_slice.mv_size = end_key.size();
+
+  MDB_dbi dbi = GetDbi(table);
+  int ret;
+  // the whole range goes in one write transaction
+  ret = mdb_txn_begin(env_, nullptr, 0, &txn);
+  if (ret) {
+    throw utils::Exception(std::string("DeleteRange mdb_txn_begin: ") + mdb_strerror(ret));
+  }
+  ret = mdb_cursor_open(txn, dbi, &cursor);
+  if (ret) {
+    throw utils::Exception(std::string("DeleteRange mdb_cursor_open: ") + mdb_strerror(ret));
+  }
+  if (start_key.empty()) {
+    ret = mdb_cursor_get(cursor, &key_slice, &val_slice, MDB_FIRST);
+  } else {
+    key_slice.mv_data = static_cast<void *>(const_cast<char *>(start_key.data()));
+    key_slice.mv_size = start_key.size();
+    ret = mdb_cursor_get(cursor, &key_slice, &val_slice, MDB_SET_RANGE);
+  }
+  while (!ret) {
+    if (!end_key.empty() && mdb_cmp(txn, dbi, &key_slice, &end_slice) >= 0) {
+      break;
+    }
+    ret = mdb_cursor_del(cursor, 0);
+    if (ret) {
+      throw utils::Exception(std::string("DeleteRange mdb_cursor_del: ") + mdb_strerror(ret));
+    }
+    // a deleted cursor steps to the record that followed it
+    ret = mdb_cursor_get(cursor, &key_slice, &val_slice, MDB_NEXT);
+  }
+  if (ret && ret != MDB_NOTFOUND) {
+    throw utils::Exception(std::string("DeleteRange mdb_cursor_get: ") + mdb_strerror(ret));
+  }
+  mdb_cursor_close(cursor);
+  ret = mdb_txn_commit(txn);
+  if (ret) {
+    throw utils::Exception(std::string("DeleteRange mdb_txn_commit: ") + mdb_strerror(ret));
+  }
+  return kOK;
+}
+
+DB::Status LmdbDB::IncrementSingleEntry(const std::string &table, const std::string &key,
+                                        std::vector<Field> &deltas) {
+  MDB_txn *txn;
+  MDB_val key_slice, val_slice;
+
+  key_slice.mv_data = static_cast<void *>(const_cast<char *>(key.data()));
+  key_slice.mv_size = key.size();
+
+  MDB_dbi dbi = GetDbi(table);
+  int ret;
+  // write transactions are serialized, so the read and the put are atomic
+  ret = mdb_txn_begin(env_, nullptr, 0, &txn);
+  if (ret) {
+    throw utils::Exception(std::string("Increment mdb_txn_begin: ") + mdb_strerror(ret));
+  }
+  std::vector<Field> current_values;
+  ret = mdb_get(txn, dbi, &key_slice, &val_slice);
+  if (ret == 0) {
+    DeserializeRow(&current_values, static_cast<char *>(val_slice.mv_data), val_slice.mv_size);
+  } else if (ret != MDB_NOTFOUND) {
+    throw utils::Exception(std::string("Increment mdb_get: ") + mdb_strerror(ret));
+  }
+  for (Field &delta : deltas) {
+    bool found = false;
+    for (Field &cur_field : current_values) {
+      if (cur_field.name == delta.name) {
+        found = true;
+        cur_field.value = utils::EncodeFixed64(utils::DecodeFixed64(cur_field.value) +
+                                               utils::DecodeFixed64(delta.value));
+        break;
+      }
+    }
+    if (!found) {
+      current_values.push_back(delta);
+    }
+  }
+
+  std::string data;
+  SerializeRow(current_values, &data);
+  val_slice.mv_data = const_cast<char *>(data.data());
+  val_slice.mv_size = data.size();
+  ret = mdb_put(txn, dbi, &key_slice, &val_slice, 0);
+  if (ret) {
+    throw utils::Exception(std::string("Increment mdb_put: ") + mdb_strerror(ret));
+  }
+
+  ret = mdb_txn_commit(txn);
+  if (ret) {
+    throw utils::Exception(std::string("Increment mdb_txn_commit: ") + mdb_strerror(ret));
+  }
+  return kOK;
+}
+
+DB::Status LmdbDB::HoldSnapshot() {
+  ReleaseSnapshot();
+  // pages freed after the transaction began cannot be reused until it ends
+  int ret = mdb_txn_begin(env_, nullptr, MDB_RDONLY, &snapshot_txn_);
+  if (ret) {
+    snapshot_txn_ = nullptr;
+    throw utils::Exception(std::string("HoldSnapshot mdb_txn_begin: ") + mdb_strerror(ret));
+  }
+  return kOK;
+}
+
+DB::Status LmdbDB::ReleaseSnapshot() {
+  if (snapshot_txn_ != nullptr) {
+    mdb_txn_abort(snapshot_txn_);
+    snapshot_txn_ = nullptr;
+  }
+  return kOK;
+}
+
+DB::Status LmdbDB::GetSpaceStats(std::map<std::string, uint64_t> &stats) {
+  MDB_envinfo info;
+  MDB_stat stat;
+  int ret = mdb_env_info(env_, &info);
+  if (!ret) {
+    ret = mdb_env_stat(env_, &stat);
+  }
+  if (ret) {
+    throw utils::Exception(std::string("GetSpaceStats mdb_env_info: ") + mdb_strerror(ret));
+  }
+  stats["lmdb.used-bytes"] = (info.me_last_pgno + 1) * stat.ms_psize;
+  stats["lmdb.readers"] = info.me_numreaders;
+
+  // the freelist is database 0, each record a page count followed by the page numbers
+  MDB_txn *txn;
+  MDB_cursor *cursor;
+  MDB_val key_slice, val_slice;
+  ret = mdb_txn_begin(env_, nullptr, MDB_RDONLY, &txn);
+  if (ret) {
+    throw utils::Exception(std::string("GetSpaceStats mdb_txn_begin: ") + mdb_strerror(ret));
+  }
+  ret = mdb_cursor_open(txn, 0, &cursor);
+  if (ret) {
+    mdb_txn_abort(txn);
+    throw utils::Exception(std::string("GetSpaceStats mdb_cursor_open: ") + mdb_strerror(ret));
+  }
+  uint64_t free_pages = 0;
+  while (!(ret = mdb_cursor_get(cursor, &key_slice, &val_slice, MDB_NEXT))) {
+    free_pages += *static_cast<size_t *>(val_slice.mv_data);
+  }
+  mdb_cursor_close(cursor);
+  mdb_txn_abort(txn);
+  if (ret != MDB_NOTFOUND) {
+    throw utils::Exception(std::string("GetSpaceStats mdb_cursor_get: ") + mdb_strerror(ret));
+  }
+  stats["lmdb.free-pages"] = free_pages;
+  stats["lmdb.free-bytes"] = free_pages * stat.ms_psize;
+  return kOK;
+}
+
 DB *NewLmdbDB() {
   return new LmdbDB;
 }
@@ -8,6 +8,7 @@
 #ifndef YCSB_C_LMDB_DB_H_
 #define YCSB_C_LMDB_DB_H_
 
+#include <map>
 #include <string>
 #include <mutex>
 
@@ -19,7 +20,7 @@ namespace ycsbc {
 
 class LmdbDB : public DB {
  public:
-  LmdbDB() {}
+  LmdbDB() : snapshot_txn_(nullptr) {}
   ~LmdbDB() {}
 
   void Init();
@@ -36,6 +37,18 @@ class LmdbDB : public DB {
     return (this->*(method_scan_))(table, key, len, fields, result);
   }
 
+  Status ScanRange(const std::string &table, const std::string &start_key,
+                   const std::string &end_key, int len, bool reverse,
+                   const std::vector<std::string> *fields,
+                   std::vector<std::vector<Field>> &result) {
+    return (this->*(method_scan_range_))(table, start_key, end_key, len, reverse, fields, result);
+  }
+
+  Status FullScan(const std::string &table, const std::string &start_key,
+                  const std::string &end_key, uint64_t &records, uint64_t &bytes) {
+    return (this->*(method_full_scan_))(table, start_key, end_key, records, bytes);
+  }
+
   Status Update(const std::string &table, const std::string &key, std::vector<Field> &values) {
     return (this->*(method_update_))(table, key, values);
   }
@@ -48,6 +61,19 @@ class LmdbDB : public DB {
     return (this->*(method_delete_))(table, key);
   }
 
+  Status DeleteRange(const std::string &table, const std::string &start_key,
+                     const std::string &end_key) {
+    return (this->*(method_delete_range_))(table, start_key, end_key);
+  }
+
+  Status Increment(const std::string &table, const std::string &key, std::vector<Field> &deltas) {
+    return (this->*(method_increment_))(table, key, deltas);
+  }
+
+  Status HoldSnapshot();
+  Status ReleaseSnapshot();
+  Status GetSpaceStats(std::map<std::string, uint64_t> &stats);
+
  private:
   enum LmdbFormat {
     kSingleEntry,
@@ -56,6 +82,8 @@ class LmdbDB : public DB {
   };
   LmdbFormat format_;
 
+  MDB_dbi GetDbi(const std::string &table);
+
   void SerializeRow(const std::vector<Field> &values, std::string *data);
   void DeserializeRowFilter(std::vector<Field> *values, const char *data_ptr, size_t data_len,
                             const std::vector<std::string> &fields);
@@ -66,26 +94,50 @@ class LmdbDB : public DB {
   Status ScanSingleEntry(const std::string &table, const std::string &key, int len,
                          const std::vector<std::string> *fields,
                          std::vector<std::vector<Field>> &result);
+  Status ScanRangeSingleEntry(const std::string &table, const std::string &start_key,
+                              const std::string &end_key, int len, bool reverse,
+                              const std::vector<std::string> *fields,
+                              std::vector<std::vector<Field>> &result);
+  Status FullScanSingleEntry(const std::string &table, const std::string &start_key,
+                             const std::string &end_key, uint64_t &records, uint64_t &bytes);
   Status UpdateSingleEntry(const std::string &table, const std::string &key,
                            std::vector<Field> &values);
   Status InsertSingleEntry(const std::string &table, const std::string &key,
                            std::vector<Field> &values);
   Status DeleteSingleEntry(const std::string &table, const std::string &key);
+  Status DeleteRangeSingleEntry(const std::string &table, const std::string &start_key,
+                                const std::string &end_key);
+  Status IncrementSingleEntry(const std::string &table, const std::string &key,
+                              std::vector<Field> &deltas);
 
   Status (LmdbDB::*method_read_)(const std::string &, const std:: string &,
                                  const std::vector<std::string> *, std::vector<Field> &);
   Status (LmdbDB::*method_scan_)(const std::string &, const std::string &, int,
                                  const std::vector<std::string> *,
                                  std::vector<std::vector<Field>> &);
+  Status (LmdbDB::*method_scan_range_)(const std::string &, const std::string &,
+                                       const std::string &, int, bool,
+                                       const std::vector<std::string> *,
+                                       std::vector<std::vector<Field>> &);
+  Status (LmdbDB::*method_full_scan_)(const std::string &, const std::string &,
+                                      const std::string &, uint64_t &, uint64_t &);
   Status (LmdbDB::*method_update_)(const std::string &, const std::string &, std::vector<Field> &);
   Status (LmdbDB::*method_insert_)(const std::string &, const std::string &, std::vector<Field> &);
   Status (LmdbDB::*method_delete_)(const std::string &, const std::string &);
+  Status (LmdbDB::*method_delete_range_)(const std::string &, const std::string &,
+                                         const std::string &);
+  Status (LmdbDB::*method_increment_)(const std::string &, const std::string &,
+                                      std::vector<Field> &);
 
   unsigned fieldcount_;
   std::string field_prefix_;
+  std::map<std::string, MDB_dbi> dbi_cache_;
+  MDB_txn *snapshot_txn_; // read transaction held by HoldSnapshot
 
   static MDB_env *env_;
   static MDB_dbi dbi_;
+  static bool multitable_;
+  static std::map<std::string, MDB_dbi> dbis_;
   static int ref_cnt_;
   static std::mutex mutex_;
 };
@@ -15,9 +15,13 @@
 #include <rocksdb/cache.h>
 #include <rocksdb/filter_policy.h>
 #include <rocksdb/merge_operator.h>
+#include <rocksdb/slice_transform.h>
 #include <rocksdb/status.h>
+#include <rocksdb/table.h>
+#include <rocksdb/utilities/db_ttl.h>
 #include <rocksdb/utilities/options_util.h>
 #include <rocksdb/write_batch.h>
+#include <algorithm>
 #include <iostream>
 
 namespace {
@@ -30,6 +34,21 @@ namespace {
   const std::string PROP_MERGEUPDATE = "rocksdb.mergeupdate";
   const std::string PROP_MERGEUPDATE_DEFAULT = "false";
 
+  const std::string PROP_MULTITABLE = "rocksdb.multitable";
+  const std::string PROP_MULTITABLE_DEFAULT = "false";
+
+  const std::string PROP_TTL = "rocksdb.ttl";
+  const std::string PROP_TTL_DEFAULT = "0";
+
+  const std::string PROP_TRANSACTION = "rocksdb.transaction";
+  const std::string PROP_TRANSACTION_DEFAULT = "none";
+
+  const std::string PROP_LOCK_TIMEOUT = "rocksdb.lock_timeout";
+  const std::string PROP_LOCK_TIMEOUT_DEFAULT = "1000";
+
+  const std::string PROP_DEADLOCK_DETECT = "rocksdb.deadlock_detect";
+  const std::string PROP_DEADLOCK_DETECT_DEFAULT = "false";
+
   const std::string PROP_DESTROY = "rocksdb.destroy";
   const std::string PROP_DESTROY_DEFAULT = "false";
 
@@ -90,12 +109,39 @@ namespace {
   const std::string PROP_BLOOM_BITS = "rocksdb.bloom_bits";
   const std::string PROP_BLOOM_BITS_DEFAULT = "0";
 
+  const std::string PROP_PREFIX_EXTRACTOR = "rocksdb.prefix_extractor";
+  const std::string PROP_PREFIX_EXTRACTOR_DEFAULT = "";
+
+  const std::string PROP_MEMTABLE_PREFIX_BLOOM = "rocksdb.memtable_prefix_bloom_size_ratio";
+  const std::string PROP_MEMTABLE_PREFIX_BLOOM_DEFAULT = "0";
+
+  const std::string PROP_WHOLE_KEY_FILTERING = "rocksdb.whole_key_filtering";
+  const std::string PROP_WHOLE_KEY_FILTERING_DEFAULT = "true";
+
+  const std::string PROP_ENABLE_BLOB_FILES = "rocksdb.enable_blob_files";
+  const std::string PROP_ENABLE_BLOB_FILES_DEFAULT = "false";
+
+  const std::string PROP_MIN_BLOB_SIZE = "rocksdb.min_blob_size";
+  const std::string PROP_MIN_BLOB_SIZE_DEFAULT = "0";
+
+  const std::string PROP_BLOB_FILE_SIZE = "rocksdb.blob_file_size";
+  const std::string PROP_BLOB_FILE_SIZE_DEFAULT = "0";
+
+  const std::string PROP_BLOB_GC = "rocksdb.enable_blob_garbage_collection";
+  const std::string PROP_BLOB_GC_DEFAULT = "false";
+
+  const std::string PROP_BLOB_GC_AGE_CUTOFF = "rocksdb.blob_garbage_collection_age_cutoff";
+  const std::string PROP_BLOB_GC_AGE_CUTOFF_DEFAULT = "0";
+
   const std::string PROP_INCREASE_PARALLELISM = "rocksdb.increase_parallelism";
   const std::string PROP_INCREASE_PARALLELISM_DEFAULT = "false";
 
   const std::string PROP_OPTIMIZE_LEVELCOMP = "rocksdb.optimize_level_style_compaction";
   const std::string PROP_OPTIMIZE_LEVELCOMP_DEFAULT = "false";
 
+  const std::string PROP_SCAN_READAHEAD_SIZE = "rocksdb.scan_readahead_size";
+  const std::string PROP_SCAN_READAHEAD_SIZE_DEFAULT = "0";
+
   const std::string PROP_OPTIONS_FILE = "rocksdb.optionsfile";
   const std::string PROP_OPTIONS_FILE_DEFAULT = "";
 
@@ -108,11 +154,43 @@ namespace {
   static std::shared_ptr<rocksdb::Env> env_guard;
   static std::shared_ptr<rocksdb::Cache> block_cache;
   static std::shared_ptr<rocksdb::Cache> block_cache_compressed;
+  static rocksdb::ColumnFamilyOptions cf_options;
+  static rocksdb::TransactionOptions txn_options;
+
+  // lock timeouts and deadlocks of pessimistic transactions and validation
+  // failures of optimistic ones
+  bool IsConflict(const rocksdb::Status &s) {
+    return s.IsBusy() || s.IsTimedOut() || s.IsTryAgain();
+  }
+
+  // whether all keys in [start_key, end_key) share the prefix of prefix_len bytes of start_key
+  bool WithinPrefix(const std::string &start_key, const std::string &end_key,
+                    size_t prefix_len) {
+    if (prefix_len == 0 || start_key.size() < prefix_len || end_key.empty()) {
+      return false;
+    }
+    std::string limit = start_key.substr(0, prefix_len);
+    while (!limit.empty() && static_cast<unsigned char>(limit.back()) == 0xff) {
+      limit.pop_back();
+    }
+    if (limit.empty()) {
+      return false;
+    }
+    limit.back()++;
+    return end_key <= limit;
+  }
 } // anonymous
 
 namespace ycsbc {
 
 rocksdb::DB *RocksdbDB::db_ = nullptr;
+rocksdb::TransactionDB *RocksdbDB::txn_db_ = nullptr;
+rocksdb::OptimisticTransactionDB *RocksdbDB::optimistic_txn_db_ = nullptr;
+bool RocksdbDB::multitable_ = false;
+int32_t RocksdbDB::ttl_ = 0;
+size_t RocksdbDB::prefix_len_ = 0;
+size_t RocksdbDB::scan_readahead_size_ = 0;
+std::map<std::string, rocksdb::ColumnFamilyHandle *> RocksdbDB::cf_handles_;
 int RocksdbDB::ref_cnt_ = 0;
 std::mutex RocksdbDB::mu_;
 
@@ -158,6 +236,45 @@ void RocksdbDB::Init() {
       return "YCSBUpdateMerge";
     }
   };
+
+  class YCSBCounterMerge : public rocksdb::AssociativeMergeOperator {
+   public:
+    virtual bool Merge(const rocksdb::Slice &key, const rocksdb::Slice *existing_value,
+                       const rocksdb::Slice &value, std::string *new_value,
+                       rocksdb::Logger *logger) const override {
+      std::vector<Field> values;
+      if (existing_value) {
+        DeserializeRow(values, existing_value->data(),
+                       existing_value->data() + existing_value->size());
+      }
+
+      std::vector<Field> deltas;
+      DeserializeRow(deltas, value.data(), value.data() + value.size());
+
+      for (Field &delta : deltas) {
+        bool found = false;
+        for (Field &field : values) {
+          if (field.name == delta.name) {
+            found = true;
+            field.value = utils::EncodeFixed64(utils::DecodeFixed64(field.value) +
+                                               utils::DecodeFixed64(delta.value));
+            break;
+          }
+        }
+        if (!found) {
+          values.push_back(delta);
+        }
+      }
+
+      new_value->clear();
+      SerializeRow(values, *new_value);
+      return true;
+    }
+
+    virtual const char *Name() const override {
+      return "YCSBCounterMerge";
+    }
+  };
 #endif
   const std::lock_guard<std::mutex> lock(mu_);
 
@@ -167,12 +284,17 @@ void RocksdbDB::Init() {
     format_ = kSingleRow;
     method_read_ = &RocksdbDB::ReadSingle;
     method_scan_ = &RocksdbDB::ScanSingle;
+    method_scan_range_ = &RocksdbDB::ScanRangeSingle;
     method_update_ = &RocksdbDB::UpdateSingle;
     method_insert_ = &RocksdbDB::InsertSingle;
     method_delete_ = &RocksdbDB::DeleteSingle;
+    method_delete_range_ = &RocksdbDB::DeleteRangeSingle;
+    method_increment_ = nullptr;
 #ifdef USE_MERGEUPDATE
     if (props.GetProperty(PROP_MERGEUPDATE, PROP_MERGEUPDATE_DEFAULT) == "true") {
       method_update_ = &RocksdbDB::MergeSingle;
+    } else {
+      method_increment_ = &RocksdbDB::IncrementSingle;
     }
 #endif
   } else {
@@ -197,7 +319,15 @@ void RocksdbDB::Init() {
   std::vector<rocksdb::ColumnFamilyHandle *> cf_handles;
   GetOptions(props, &opt, &cf_descs);
 #ifdef USE_MERGEUPDATE
-  opt.merge_operator.reset(new YCSBUpdateMerge);
+  // merges either update fields or add to counters
+  if (props.GetProperty(PROP_MERGEUPDATE, PROP_MERGEUPDATE_DEFAULT) == "true") {
+    opt.merge_operator.reset(new YCSBUpdateMerge);
+  } else {
+    opt.merge_operator.reset(new YCSBCounterMerge);
+  }
+  for (rocksdb::ColumnFamilyDescriptor &desc : cf_descs) {
+    desc.options.merge_operator = opt.merge_operator;
+  }
 #endif
 
   rocksdb::Status s;
@@ -207,7 +337,63 @@ void RocksdbDB::Init() {
       throw utils::Exception(std::string("RocksDB DestroyDB: ") + s.ToString());
     }
   }
-  if (cf_descs.empty()) {
+
+  // each table is stored in the column family of the same name
+  multitable_ = props.GetProperty(PROP_MULTITABLE, PROP_MULTITABLE_DEFAULT) == "true";
+  cf_options = rocksdb::ColumnFamilyOptions(opt);
+  if (multitable_ && cf_descs.empty()) {
+    std::vector<std::string> cf_names;
+    s = rocksdb::DB::ListColumnFamilies(opt, db_path, &cf_names);
+    if (s.ok()) {
+      for (const std::string &name : cf_names) {
+        cf_descs.emplace_back(name, cf_options);
+      }
+    }
+  }
+
+  // zero leaves full scans to the automatic readahead of RocksDB
+  scan_readahead_size_ = std::stoul(props.GetProperty(PROP_SCAN_READAHEAD_SIZE,
+                                                      PROP_SCAN_READAHEAD_SIZE_DEFAULT));
+
+  // with a ttl, compactions drop records written more than ttl seconds ago
+  ttl_ = std::stoi(props.GetProperty(PROP_TTL, PROP_TTL_DEFAULT));
+  const std::string txn_mode = props.GetProperty(PROP_TRANSACTION, PROP_TRANSACTION_DEFAULT);
+  if (txn_mode != "none" && ttl_ > 0) {
+    throw utils::Exception("rocksdb.ttl cannot be combined with rocksdb.transaction");
+  }
+  if (txn_mode == "pessimistic") {
+    rocksdb::TransactionDBOptions txn_db_opt;
+    txn_options.lock_timeout = std::stoll(props.GetProperty(PROP_LOCK_TIMEOUT,
+                                                            PROP_LOCK_TIMEOUT_DEFAULT));
+    txn_options.deadlock_detect = props.GetProperty(PROP_DEADLOCK_DETECT,
+                                                    PROP_DEADLOCK_DETECT_DEFAULT) == "true";
+    if (cf_descs.empty()) {
+      s = rocksdb::TransactionDB::Open(opt, txn_db_opt, db_path, &txn_db_);
+    } else {
+      s = rocksdb::TransactionDB::Open(opt, txn_db_opt, db_path, cf_descs, &cf_handles,
+                                       &txn_db_);
+    }
+    db_ = txn_db_;
+  } else if (txn_mode == "optimistic") {
+    if (cf_descs.empty()) {
+      s = rocksdb::OptimisticTransactionDB::Open(opt, db_path, &optimistic_txn_db_);
+    } else {
+      s = rocksdb::OptimisticTransactionDB::Open(opt, db_path, cf_descs, &cf_handles,
+                                                 &optimistic_txn_db_);
+    }
+    db_ = optimistic_txn_db_;
+  } else if (txn_mode != "none") {
+    throw utils::Exception("Unknown rocksdb.transaction: " + txn_mode);
+  } else if (ttl_ > 0) {
+    rocksdb::DBWithTTL *ttl_db = nullptr;
+    if (cf_descs.empty()) {
+      s = rocksdb::DBWithTTL::Open(opt, db_path, &ttl_db, ttl_);
+    } else {
+      std::vector<int32_t> ttls(cf_descs.size(), ttl_);
+      s = rocksdb::DBWithTTL::Open(opt, db_path, cf_descs, &cf_handles, &ttl_db, ttls);
+    }
+    db_ = ttl_db;
+  } else if (cf_descs.empty()) {
     s = rocksdb::DB::Open(opt, db_path, &db_);
   } else {
     s = rocksdb::DB::Open(opt, db_path, cf_descs, &cf_handles, &db_);
@@ -215,9 +401,47 @@ void RocksdbDB::Init() {
   if (!s.ok()) {
     throw utils::Exception(std::string("RocksDB Open: ") + s.ToString());
   }
+  for (rocksdb::ColumnFamilyHandle *handle : cf_handles) {
+    cf_handles_[handle->GetName()] = handle;
+  }
+}
+
+rocksdb::ColumnFamilyHandle *RocksdbDB::GetColumnFamily(const std::string &table) {
+  if (!multitable_) {
+    return db_->DefaultColumnFamily();
+  }
+  auto it = cf_cache_.find(table);
+  if (it != cf_cache_.end()) {
+    return it->second;
+  }
+
+  const std::lock_guard<std::mutex> lock(mu_);
+  rocksdb::ColumnFamilyHandle *handle;
+  auto global_it = cf_handles_.find(table);
+  if (global_it != cf_handles_.end()) {
+    handle = global_it->second;
+  } else {
+    rocksdb::Status s;
+    if (ttl_ > 0) {
+      s = static_cast<rocksdb::DBWithTTL *>(db_)->CreateColumnFamilyWithTtl(cf_options, table,
+                                                                           &handle, ttl_);
+    } else {
+      s = db_->CreateColumnFamily(cf_options, table, &handle);
+    }
+    if (!s.ok()) {
+      throw utils::Exception(std::string("RocksDB CreateColumnFamily: ") + s.ToString());
+    }
+    cf_handles_[table] = handle;
+  }
+  cf_cache_[table] = handle;
+  return handle;
 }
 
 void RocksdbDB::Cleanup() {
+  delete txn_;
+  txn_ = nullptr;
+  ReleaseSnapshot();
+
   const std::lock_guard<std::mutex> lock(mu_);
   if (--ref_cnt_) {
     return;
@@ -232,7 +456,13 @@ void RocksdbDB::Cleanup() {
             << options.statistics->getTickerCount(rocksdb::GET_MISS_L1) << std::endl
             << options.statistics->getTickerCount(rocksdb::GET_HIT_L2_AND_UP) << "/"
             << options.statistics->getTickerCount(rocksdb::GET_MISS_L2_AND_UP) << std::endl;
+  for (auto &entry : cf_handles_) {
+    db_->DestroyColumnFamilyHandle(entry.second);
+  }
+  cf_handles_.clear();
   delete db_;
+  txn_db_ = nullptr;
+  optimistic_txn_db_ = nullptr;
 }
 
 void RocksdbDB::GetOptions(const utils::Properties &props, rocksdb::Options *opt,
@@ -259,6 +489,63 @@ void RocksdbDB::GetOptions(const utils::Properties &props, rocksdb::Options *opt
   opt->compaction_style = rocksdb::kCompactionStyleUniversal;
   //opt->OptimizeLevelStyleCompaction();
   opt->nvm_path = "/mnt/pmem1/crh/nodememory";
+
+  // keys are filtered and scans bounded by prefix, given as fixed:<len> or capped:<len>
+  const std::string prefix = props.GetProperty(PROP_PREFIX_EXTRACTOR,
+                                               PROP_PREFIX_EXTRACTOR_DEFAULT);
+  prefix_len_ = 0;
+  if (!prefix.empty()) {
+    size_t pos = prefix.find(':');
+    if (pos == std::string::npos) {
+      throw utils::Exception("RocksDB prefix extractor must be fixed:<len> or capped:<len>");
+    }
+    prefix_len_ = std::stoul(prefix.substr(pos + 1));
+    if (prefix.compare(0, pos, "fixed") == 0) {
+      opt->prefix_extractor.reset(rocksdb::NewFixedPrefixTransform(prefix_len_));
+    } else if (prefix.compare(0, pos, "capped") == 0) {
+      opt->prefix_extractor.reset(rocksdb::NewCappedPrefixTransform(prefix_len_));
+    } else {
+      throw utils::Exception("Unknown RocksDB prefix extractor: " + prefix);
+    }
+    double ratio = std::stod(props.GetProperty(PROP_MEMTABLE_PREFIX_BLOOM,
+                                               PROP_MEMTABLE_PREFIX_BLOOM_DEFAULT));
+    if (ratio > 0) {
+      opt->memtable_prefix_bloom_size_ratio = ratio;
+    }
+    int bloom_bits = std::stoi(props.GetProperty(PROP_BLOOM_BITS, PROP_BLOOM_BITS_DEFAULT));
+    if (bloom_bits > 0) {
+      rocksdb::BlockBasedTableOptions table_options;
+      size_t cache_size = std::stoul(props.GetProperty(PROP_CACHE_SIZE, PROP_CACHE_SIZE_DEFAULT));
+      if (cache_size > 0) {
+        block_cache = rocksdb::NewLRUCache(cache_size);
+        table_options.block_cache = block_cache;
+      }
+      table_options.filter_policy.reset(rocksdb::NewBloomFilterPolicy(bloom_bits));
+      table_options.whole_key_filtering =
+          props.GetProperty(PROP_WHOLE_KEY_FILTERING, PROP_WHOLE_KEY_FILTERING_DEFAULT) == "true";
+      opt->table_factory.reset(rocksdb::NewBlockBasedTableFactory(table_options));
+    }
+  }
+
+  // key-value separation: values of at least min_blob_size go to blob files
+  if (props.GetProperty(PROP_ENABLE_BLOB_FILES, PROP_ENABLE_BLOB_FILES_DEFAULT) == "true") {
+    opt->enable_blob_files = true;
+    opt->min_blob_size = std::stoull(props.GetProperty(PROP_MIN_BLOB_SIZE,
+                                                       PROP_MIN_BLOB_SIZE_DEFAULT));
+    uint64_t val = std::stoull(props.GetProperty(PROP_BLOB_FILE_SIZE,
+                                                 PROP_BLOB_FILE_SIZE_DEFAULT));
+    if (val != 0) {
+      opt->blob_file_size = val;
+    }
+    if (props.GetProperty(PROP_BLOB_GC, PROP_BLOB_GC_DEFAULT) == "true") {
+      opt->enable_blob_garbage_collection = true;
+      double cutoff = std::stod(props.GetProperty(PROP_BLOB_GC_AGE_CUTOFF,
+                                                  PROP_BLOB_GC_AGE_CUTOFF_DEFAULT));
+      if (cutoff > 0) {
+        opt->blob_garbage_collection_age_cutoff = cutoff;
+      }
+    }
+  }
 }
 
 void RocksdbDB::SerializeRow(const std::vector<Field> &values, std::string &data) {
@@ -274,8 +561,9 @@ void RocksdbDB::SerializeRow(const std::vector<Field> &values, std::string &data
 
 void RocksdbDB::DeserializeRowFilter(std::vector<Field> &values, const char *p, const char *lim,
                                      const std::vector<std::string> &fields) {
-  std::vector<std::string>::const_iterator filter_iter = fields.begin();
-  while (p != lim && filter_iter != fields.end()) {
+  // records may lack some of the fields
+  size_t found = 0;
+  while (p != lim && found < fields.size()) {
     assert(p < lim);
     uint32_t len = *reinterpret_cast<const uint32_t *>(p);
     p += sizeof(uint32_t);
@@ -283,14 +571,12 @@ void RocksdbDB::DeserializeRowFilter(std::vector<Field> &values, const char *p,
     p += len;
     len = *reinterpret_cast<const uint32_t *>(p);
     p += sizeof(uint32_t);
-    std::string value(p, static_cast<const size_t>(len));
-    p += len;
-    if (*filter_iter == field) {
-      values.push_back({field, value});
-      filter_iter++;
+    if (std::find(fields.begin(), fields.end(), field) != fields.end()) {
+      values.push_back({field, std::string(p, static_cast<const size_t>(len))});
+      found++;
     }
+    p += len;
   }
-  assert(values.size() == fields.size());
 }
 
 void RocksdbDB::DeserializeRowFilter(std::vector<Field> &values, const std::string &data,
@@ -325,9 +611,17 @@ DB::Status RocksdbDB::ReadSingle(const std::string &table, const std::string &ke
                                  const std::vector<std::string> *fields,
                                  std::vector<Field> &result) {
   std::string data;
-  rocksdb::Status s = db_->Get(rocksdb::ReadOptions(), key, &data);
+  rocksdb::Status s;
+  if (txn_ != nullptr) {
+    // locks the record, or has it validated at commit
+    s = txn_->GetForUpdate(rocksdb::ReadOptions(), GetColumnFamily(table), key, &data);
+  } else {
+    s = db_->Get(rocksdb::ReadOptions(), GetColumnFamily(table), key, &data);
+  }
   if (s.IsNotFound()) {
     return kNotFound;
+  } else if (txn_ != nullptr && IsConflict(s)) {
+    return kAborted;
   } else if (!s.ok()) {
     throw utils::Exception(std::string("RocksDB Get: ") + s.ToString());
   }
@@ -335,7 +629,6 @@ DB::Status RocksdbDB::ReadSingle(const std::string &table, const std::string &ke
     DeserializeRowFilter(result, data, *fields);
   } else {
     DeserializeRow(result, data);
-    assert(result.size() == static_cast<size_t>(fieldcount_));
   }
   return kOK;
 }
@@ -343,7 +636,10 @@ DB::Status RocksdbDB::ReadSingle(const std::string &table, const std::string &ke
 DB::Status RocksdbDB::ScanSingle(const std::string &table, const std::string &key, int len,
                                  const std::vector<std::string> *fields,
                                  std::vector<std::vector<Field>> &result) {
-  rocksdb::Iterator *db_iter = db_->NewIterator(rocksdb::ReadOptions());
+  rocksdb::ReadOptions ropt;
+  // len records may run past the prefix of the start key
+  ropt.total_order_seek = true;
+  rocksdb::Iterator *db_iter = db_->NewIterator(ropt, GetColumnFamily(table));
   db_iter->Seek(key);
   for (int i = 0; db_iter->Valid() && i < len; i++) {
     std::string data = db_iter->value().ToString();
@@ -353,7 +649,6 @@ DB::Status RocksdbDB::ScanSingle(const std::string &table, const std::string &ke
       DeserializeRowFilter(values, data, *fields);
     } else {
       DeserializeRow(values, data);
-      assert(values.size() == static_cast<size_t>(fieldcount_));
     }
     db_iter->Next();
   }
@@ -361,6 +656,77 @@ DB::Status RocksdbDB::ScanSingle(const std::string &table, const std::string &ke
   return kOK;
 }
 
+DB::Status RocksdbDB::ScanRangeSingle(const std::string &table, const std::string &start_key,
+                                      const std::string &end_key, int len, bool reverse,
+                                      const std::vector<std::string> *fields,
+                                      std::vector<std::vector<Field>> &result) {
+  rocksdb::ReadOptions ropt;
+  // a forward scan within one prefix seeks in prefix mode, using the prefix blooms;
+  // otherwise the bounds, not the prefix extractor, end the scan
+  ropt.prefix_same_as_start = !reverse && WithinPrefix(start_key, end_key, prefix_len_);
+  ropt.total_order_seek = !ropt.prefix_same_as_start;
+  rocksdb::Slice lower(start_key);
+  rocksdb::Slice upper(end_key);
+  if (!start_key.empty()) {
+    ropt.iterate_lower_bound = &lower;
+  }
+  if (!end_key.empty()) {
+    ropt.iterate_upper_bound = &upper;
+  }
+  rocksdb::Iterator *db_iter = db_->NewIterator(ropt, GetColumnFamily(table));
+  if (!reverse) {
+    db_iter->Seek(start_key);
+  } else if (end_key.empty()) {
+    db_iter->SeekToLast();
+  } else {
+    db_iter->SeekForPrev(end_key);
+  }
+  for (int i = 0; db_iter->Valid() && i < len; i++) {
+    std::string data = db_iter->value().ToString();
+    result.push_back(std::vector<Field>());
+    std::vector<Field> &values = result.back();
+    if (fields != nullptr) {
+      DeserializeRowFilter(values, data, *fields);
+    } else {
+      DeserializeRow(values, data);
+    }
+    if (reverse) {
+      db_iter->Prev();
+    } else {
+      db_iter->Next();
+    }
+  }
+  delete db_iter;
+  return kOK;
+}
+
+DB::Status RocksdbDB::FullScan(const std::string &table, const std::string &start_key,
+                               const std::string &end_key, uint64_t &records,
+                               uint64_t &bytes) {
+  rocksdb::ReadOptions ropt;
+  ropt.total_order_seek = true;
+  ropt.readahead_size = scan_readahead_size_;
+  // a one-off pass over the table would only evict the working set
+  ropt.fill_cache = false;
+  rocksdb::Slice upper(end_key);
+  if (!end_key.empty()) {
+    ropt.iterate_upper_bound = &upper;
+  }
+  rocksdb::Iterator *db_iter = db_->NewIterator(ropt, GetColumnFamily(table));
+  records = 0;
+  bytes = 0;
+  for (db_iter->Seek(start_key); db_iter->Valid(); db_iter->Next()) {
+    records++;
+    bytes += db_iter->key().size() + db_iter->value().size();
+  }
+  rocksdb::Status s = db_iter->status();
+  delete db_iter;
+  if (!s.ok()) {
+    throw utils::Exception(std::string("RocksDB FullScan: ") + s.ToString());
+  }
+  return kOK;
+}
+
 DB::Status RocksdbDB::UpdateSingle(const std::string &table, const std::string &key,
                                    std::vector<Field> &values) {
   return InsertSingle(table, key, values);
@@ -371,8 +737,26 @@ DB::Status RocksdbDB::MergeSingle(const std::string &table, const std::string &k
   std::string data;
   SerializeRow(values, data);
   rocksdb::WriteOptions wopt;
-  rocksdb::Status s = db_->Merge(wopt, key, data);
-  if (!s.ok()) {
+  rocksdb::Status s = txn_ != nullptr ? txn_->Merge(GetColumnFamily(table), key, data)
+                                      : db_->Merge(wopt, GetColumnFamily(table), key, data);
+  if (txn_ != nullptr && IsConflict(s)) {
+    return kAborted;
+  } else if (!s.ok()) {
+    throw utils::Exception(std::string("RocksDB Merge: ") + s.ToString());
+  }
+  return kOK;
+}
+
+DB::Status RocksdbDB::IncrementSingle(const std::string &table, const std::string &key,
+                                      std::vector<Field> &deltas) {
+  std::string data;
+  SerializeRow(deltas, data);
+  rocksdb::WriteOptions wopt;
+  rocksdb::Status s = txn_ != nullptr ? txn_->Merge(GetColumnFamily(table), key, data)
+                                      : db_->Merge(wopt, GetColumnFamily(table), key, data);
+  if (txn_ != nullptr && IsConflict(s)) {
+    return kAborted;
+  } else if (!s.ok()) {
     throw utils::Exception(std::string("RocksDB Merge: ") + s.ToString());
   }
   return kOK;
@@ -383,8 +767,11 @@ DB::Status RocksdbDB::InsertSingle(const std::string &table, const std::string &
   std::string data;
   SerializeRow(values, data);
   rocksdb::WriteOptions wopt;
-  rocksdb::Status s = db_->Put(wopt, key, data);
-  if (!s.ok()) {
+  rocksdb::Status s = txn_ != nullptr ? txn_->Put(GetColumnFamily(table), key, data)
+                                      : db_->Put(wopt, GetColumnFamily(table), key, data);
+  if (txn_ != nullptr && IsConflict(s)) {
+    return kAborted;
+  } else if (!s.ok()) {
     throw utils::Exception(std::string("RocksDB Put: ") + s.ToString());
   }
   return kOK;
@@ -392,13 +779,140 @@ DB::Status RocksdbDB::InsertSingle(const std::string &table, const std::string &
 
 DB::Status RocksdbDB::DeleteSingle(const std::string &table, const std::string &key) {
   rocksdb::WriteOptions wopt;
-  rocksdb::Status s = db_->Delete(wopt, key);
-  if (!s.ok()) {
+  rocksdb::Status s = txn_ != nullptr ? txn_->Delete(GetColumnFamily(table), key)
+                                      : db_->Delete(wopt, GetColumnFamily(table), key);
+  if (txn_ != nullptr && IsConflict(s)) {
+    return kAborted;
+  } else if (!s.ok()) {
     throw utils::Exception(std::string("RocksDB Delete: ") + s.ToString());
   }
   return kOK;
 }
 
+DB::Status RocksdbDB::DeleteRangeSingle(const std::string &table, const std::string &start_key,
+                                        const std::string &end_key) {
+  if (txn_ != nullptr) {
+    // RocksDB transactions have no range deletion, and writing around one breaks its isolation
+    throw utils::Exception("RocksDB range deletions cannot be part of a transaction");
+  }
+  rocksdb::ColumnFamilyHandle *cf = GetColumnFamily(table);
+  std::string end = end_key;
+  if (end.empty()) {
+    // a range tombstone needs an end, so bound it right after the last key
+    rocksdb::ReadOptions ropt;
+    ropt.total_order_seek = true;
+    rocksdb::Iterator *db_iter = db_->NewIterator(ropt, cf);
+    db_iter->SeekToLast();
+    bool empty = !db_iter->Valid();
+    if (!empty) {
+      end = db_iter->key().ToString().append(1, '\0');
+    }
+    delete db_iter;
+    if (empty) {
+      return kOK;
+    }
+  }
+  rocksdb::WriteOptions wopt;
+  rocksdb::Status s = db_->DeleteRange(wopt, cf, start_key, end);
+  if (!s.ok()) {
+    throw utils::Exception(std::string("RocksDB DeleteRange: ") + s.ToString());
+  }
+  return kOK;
+}
+
+DB::Status RocksdbDB::Begin() {
+  if (txn_db_ == nullptr && optimistic_txn_db_ == nullptr) {
+    return kNotImplemented;
+  }
+  if (txn_ != nullptr) {
+    throw utils::Exception("RocksDB Begin: a transaction is already open");
+  }
+  rocksdb::WriteOptions wopt;
+  if (txn_db_ != nullptr) {
+    txn_ = txn_db_->BeginTransaction(wopt, txn_options);
+  } else {
+    txn_ = optimistic_txn_db_->BeginTransaction(wopt);
+  }
+  return kOK;
+}
+
+DB::Status RocksdbDB::Commit() {
+  if (txn_ == nullptr) {
+    throw utils::Exception("RocksDB Commit: no transaction is open");
+  }
+  rocksdb::Status s = txn_->Commit();
+  // a transaction that failed to commit is rolled back when deleted
+  delete txn_;
+  txn_ = nullptr;
+  if (IsConflict(s)) {
+    return kAborted;
+  } else if (!s.ok()) {
+    throw utils::Exception(std::string("RocksDB Commit: ") + s.ToString());
+  }
+  return kOK;
+}
+
+DB::Status RocksdbDB::Rollback() {
+  if (txn_ == nullptr) {
+    return kOK;
+  }
+  rocksdb::Status s = txn_->Rollback();
+  delete txn_;
+  txn_ = nullptr;
+  if (!s.ok()) {
+    throw utils::Exception(std::string("RocksDB Rollback: ") + s.ToString());
+  }
+  return kOK;
+}
+
+DB::Status RocksdbDB::HoldSnapshot() {
+  ReleaseSnapshot();
+  snapshot_ = db_->GetSnapshot();
+  return kOK;
+}
+
+DB::Status RocksdbDB::ReleaseSnapshot() {
+  if (snapshot_ != nullptr) {
+    db_->ReleaseSnapshot(snapshot_);
+    snapshot_ = nullptr;
+  }
+  return kOK;
+}
+
+DB::Status RocksdbDB::GetSpaceStats(std::map<std::string, uint64_t> &stats) {
+  static const char *kSizeProperties[] = {
+    "rocksdb.total-sst-files-size",
+    "rocksdb.live-sst-files-size",
+    "rocksdb.estimate-live-data-size",
+    "rocksdb.size-all-mem-tables"
+  };
+  std::vector<rocksdb::ColumnFamilyHandle *> handles(1, db_->DefaultColumnFamily());
+  {
+    const std::lock_guard<std::mutex> lock(mu_);
+    for (auto &entry : cf_handles_) {
+      if (entry.first != rocksdb::kDefaultColumnFamilyName) {
+        handles.push_back(entry.second);
+      }
+    }
+  }
+  // summed over the column families
+  for (const char *name : kSizeProperties) {
+    uint64_t total = 0;
+    for (rocksdb::ColumnFamilyHandle *handle : handles) {
+      uint64_t value;
+      if (db_->GetIntProperty(handle, name, &value)) {
+        total += value;
+      }
+    }
+    stats[name] = total;
+  }
+  uint64_t value;
+  if (db_->GetIntProperty("rocksdb.num-snapshots", &value)) {
+    stats["rocksdb.num-snapshots"] = value;
+  }
+  return kOK;
+}
+
 DB *NewRocksdbDB() {
   return new RocksdbDB;
 }
@@ -8,6 +8,7 @@
 #ifndef YCSB_C_ROCKSDB_DB_H_
 #define YCSB_C_ROCKSDB_DB_H_
 
+#include <map>
 #include <string>
 #include <mutex>
 
@@ -16,12 +17,14 @@
 
 #include <rocksdb/db.h>
 #include <rocksdb/options.h>
+#include <rocksdb/utilities/optimistic_transaction_db.h>
+#include <rocksdb/utilities/transaction_db.h>
 
 namespace ycsbc {
 
 class RocksdbDB : public DB {
  public:
-  RocksdbDB() {}
+  RocksdbDB() : txn_(nullptr), snapshot_(nullptr) {}
   ~RocksdbDB() {}
 
   void Init();
@@ -38,6 +41,17 @@ class RocksdbDB : public DB {
     return (this->*(method_scan_))(table, key, len, fields, result);
   }
 
+  Status ScanRange(const std::string &table, const std::string &start_key,
+                   const std::string &end_key, int len, bool reverse,
+                   const std::vector<std::string> *fields,
+                   std::vector<std::vector<Field>> &result) {
+    return (this->*(method_scan_range_))(table, start_key, end_key, len, reverse, fields,
+                                         result);
+  }
+
+  Status FullScan(const std::string &table, const std::string &start_key,
+                  const std::string &end_key, uint64_t &records, uint64_t &bytes);
+
   Status Update(const std::string &table, const std::string &key, std::vector<Field> &values) {
     return (this->*(method_update_))(table, key, values);
   }
@@ -50,6 +64,26 @@ class RocksdbDB : public DB {
     return (this->*(method_delete_))(table, key);
   }
 
+  Status DeleteRange(const std::string &table, const std::string &start_key,
+                     const std::string &end_key) {
+    return (this->*(method_delete_range_))(table, start_key, end_key);
+  }
+
+  Status Increment(const std::string &table, const std::string &key, std::vector<Field> &deltas) {
+    if (method_increment_ == nullptr) {
+      return kNotImplemented;
+    }
+    return (this->*(method_increment_))(table, key, deltas);
+  }
+
+  Status Begin();
+  Status Commit();
+  Status Rollback();
+
+  Status HoldSnapshot();
+  Status ReleaseSnapshot();
+  Status GetSpaceStats(std::map<std::string, uint64_t> &stats);
+
  private:
   enum RocksFormat {
     kSingleRow,
@@ -58,6 +92,7 @@ class RocksdbDB : public DB {
 
   void GetOptions(const utils::Properties &props, rocksdb::Options *opt,
                   std::vector<rocksdb::ColumnFamilyDescriptor> *cf_descs);
+  rocksdb::ColumnFamilyHandle *GetColumnFamily(const std::string &table);
   static void SerializeRow(const std::vector<Field> &values, std::string &data);
   static void DeserializeRowFilter(std::vector<Field> &values, const char *p, const char *lim,
                                    const std::vector<std::string> &fields);
@@ -71,28 +106,55 @@ class RocksdbDB : public DB {
   Status ScanSingle(const std::string &table, const std::string &key, int len,
                     const std::vector<std::string> *fields,
                     std::vector<std::vector<Field>> &result);
+  Status ScanRangeSingle(const std::string &table, const std::string &start_key,
+                         const std::string &end_key, int len, bool reverse,
+                         const std::vector<std::string> *fields,
+                         std::vector<std::vector<Field>> &result);
   Status UpdateSingle(const std::string &table, const std::string &key,
                       std::vector<Field> &values);
   Status MergeSingle(const std::string &table, const std::string &key,
                      std::vector<Field> &values);
+  Status IncrementSingle(const std::string &table, const std::string &key,
+                         std::vector<Field> &deltas);
   Status InsertSingle(const std::string &table, const std::string &key,
                       std::vector<Field> &values);
   Status DeleteSingle(const std::string &table, const std::string &key);
+  Status DeleteRangeSingle(const std::string &table, const std::string &start_key,
+                           const std::string &end_key);
 
   Status (RocksdbDB::*method_read_)(const std::string &, const std:: string &,
                                     const std::vector<std::string> *, std::vector<Field> &);
   Status (RocksdbDB::*method_scan_)(const std::string &, const std::string &,
                                     int, const std::vector<std::string> *,
                                     std::vector<std::vector<Field>> &);
+  Status (RocksdbDB::*method_scan_range_)(const std::string &, const std::string &,
+                                          const std::string &, int, bool,
+                                          const std::vector<std::string> *,
+                                          std::vector<std::vector<Field>> &);
   Status (RocksdbDB::*method_update_)(const std::string &, const std::string &,
                                       std::vector<Field> &);
   Status (RocksdbDB::*method_insert_)(const std::string &, const std::string &,
                                       std::vector<Field> &);
   Status (RocksdbDB::*method_delete_)(const std::string &, const std::string &);
+  Status (RocksdbDB::*method_delete_range_)(const std::string &, const std::string &,
+                                            const std::string &);
+  Status (RocksdbDB::*method_increment_)(const std::string &, const std::string &,
+                                         std::vector<Field> &);
 
   int fieldcount_;
+  std::map<std::string, rocksdb::ColumnFamilyHandle *> cf_cache_;
+  rocksdb::Transaction *txn_; // the transaction of this thread, if one is open
+  const rocksdb::Snapshot *snapshot_;
 
   static rocksdb::DB *db_;
+  // set when db_ was opened with transactions
+  static rocksdb::TransactionDB *txn_db_;
+  static rocksdb::OptimisticTransactionDB *optimistic_txn_db_;
+  static bool multitable_;
+  static int32_t ttl_;
+  static size_t prefix_len_; // the length of the extracted prefixes, 0 without an extractor
+  static size_t scan_readahead_size_;
+  static std::map<std::string, rocksdb::ColumnFamilyHandle *> cf_handles_;
   static int ref_cnt_;
   static std::mutex mu_;
 };